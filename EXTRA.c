@@ -1,6 +1,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h> 
+#include "header.h"
 
 /**
  * The extra credit page replacement policy replaces page by picking a random 
@@ -22,11 +23,13 @@ int foundIt(int item, int mem_ref[], int capacity_e);
  * It traverses the pages that are referenced and calls the necessary methods depending
  * on whethere there was a page miss or hit. 
  * int pages[] : contains memory references entered through command line.  
+ * int runs[]: how many times in a row each reference occurred, NULL if every reference occurs once. 
+ * char hits[]: set to 1 for each reference that was found in memory, can be NULL. 
  * pageCapacity: the number of physical memory frames. 
  * numPages: the total number of memory references. 
  * state: a flag of which process is calling FIFO for printing reasons.**/ 
  
-float extra(int pages[], int numCapacity, int numPages, int state) {
+float extra(int pages[], int runs[], char hits[], int numCapacity, int numPages, int state) {
 	
 	/*initializing variables*/ 
 	int capacity_e = numCapacity;
@@ -54,6 +57,9 @@ float extra(int pages[], int numCapacity, int numPages, int state) {
 		
 		/*returns 0 if there is a page fault*/ 
 		found = foundIt(pages[i], &mem_ref[0], capacity_e);	
+		if (hits != NULL) {
+			hits[i] = found; /*record hit or fault for the caller*/ 
+		}
 		if (found) { 
 			if(!stat_e) {/*prints memory content if page simulation calls extra*/ 
 			printing(pages[i], &mem_ref[0], found, size_e, capacity_e);
@@ -75,6 +81,11 @@ float extra(int pages[], int numCapacity, int numPages, int state) {
 			printing(pages[i], &mem_ref[0], found, size_e, capacity_e);
 			}
 		}	 
+		
+		/*collapsed repeats of the page are hits, count them once memory is full*/ 
+		if (runs != NULL && size_e >= capacity_e) {
+			references_e += runs[i] - 1;
+		}
 	}
 	
 	/*calculates the miss rate and prints the appropriate information*/ 
@@ -101,15 +112,8 @@ float extra(int pages[], int numCapacity, int numPages, int state) {
  
 int foundIt(int item, int mem_ref[], int capacity_e) {
 	
-	int i = 0; 
-	/*traverses content of physical memory*/ 
-	for (i = 0; i < capacity_e; i++) {
-		if (mem_ref[i] == item) {
-			return 1; /*page hit*/ 
-		} 
-	} 
-	/*page fault*/ 
-	return 0; 
+	/*traverses content of physical memory, several frames at a time*/ 
+	return findFrame(mem_ref, capacity_e, item) >= 0; 
 }      
 
 /** 
@@ -123,6 +127,7 @@ void replace(int mem_ref[], int item, int capacity_e) {
 	
 	/*generating random number*/ 
 	int result = random() % capacity_e;  
+	PROFILE_COUNT(evictions, 1); 
 
 	/*replacing page*/ 
 	mem_ref[result] = item; 
@@ -139,6 +144,7 @@ void replace(int mem_ref[], int item, int capacity_e) {
 void printing(int item, int mem_ref[], int found, int size_e, int capacity_e) {
 	
 	int i; 
+	profilePrintStart(); 
 	printf("%2d: [", item); 
 	
 	/*prints the content of physical memory*/ 
@@ -159,5 +165,6 @@ void printing(int item, int mem_ref[], int found, int size_e, int capacity_e) {
 	else { /*page hit*/ 
 	printf("]\n");
 	}
+	profilePrintEnd(); 
 } 
 
@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "header.h"
 
 /** 
  * Implements first in first out page replacement policy by evicting the page
@@ -21,11 +22,13 @@ void printMem(int item, int mem_ref[], int found, int size, int capacity);
  * FIFO policy, otherwise the page is added to the back of the array. The method returns missRate
  * to the caller. 
  * int pages[] : contains memory references entered through command line 
+ * int runs[]: how many times in a row each reference occurred, NULL if every reference occurs once 
+ * char hits[]: set to 1 for each reference that was found in memory, can be NULL 
  * pageCapacity: the number of physical memory frames 
  * numPages: the total number of memory references
  * state: a flag of which process is calling FIFO for printing reasons **/ 
   
-float FIFO(int pages[], int pageCapacity, int numPages, int state) {
+float FIFO(int pages[], int runs[], char hits[], int pageCapacity, int numPages, int state) {
 	
 	/* initialize variables */  
 	int capacity = pageCapacity; 
@@ -57,6 +60,9 @@ float FIFO(int pages[], int pageCapacity, int numPages, int state) {
 		
 		/*returns 1 if page is found in memory*/ 
 		found = foundItem(pages[i], &mem_ref[0], capacity); 
+		if (hits != NULL) {
+			hits[i] = found; /*record hit or fault for the caller*/ 
+		}
 			
 		if (found) { 
 			if(!stat) { /*does not print if page stat calls FIFO*/ 
@@ -70,8 +76,14 @@ float FIFO(int pages[], int pageCapacity, int numPages, int state) {
 			}
 			if (size > capacity) {
 				misses++; /*memory is full start counting misses*/ 
+				PROFILE_COUNT(evictions, 1); 
 			}
 		}	 
+		
+		/*collapsed repeats of the page are hits, count them once memory is full*/ 
+		if (runs != NULL && size >= capacity) {
+			references += runs[i] - 1;
+		}
 	} 
 	
 	/*calculates miss rate and prints it accordingly*/ 
@@ -121,16 +133,8 @@ void enqueue(int page, int *current, int mem_ref[], int *size, int capacity) {
  
 int foundItem(int item, int mem_ref[], int capacity) {
 	
-	int i = 0; 
-	/*traverses through physical memory*/ 
-	for (i = 0; i < capacity; i++) {
-		if (mem_ref[i] == item) {
-			/*found*/ 
-			return 1; 
-		} 
-	} 
-	/*page fault*/ 
-	return 0; 
+	/*traverses through physical memory, several frames at a time*/ 
+	return findFrame(mem_ref, capacity, item) >= 0; 
 } 
 
 /** Prints the current content of physical memory according to whether there is a miss or a hit. 
@@ -143,6 +147,7 @@ int foundItem(int item, int mem_ref[], int capacity) {
 void printMem(int item, int mem_ref[], int found, int size, int capacity) {
 	
 	int i; 
+	profilePrintStart(); 
 	printf("%2d: [", item); 
 	/* prints content of physical memory*/ 
 	for (i = 0; i < capacity; i++) {
@@ -161,6 +166,7 @@ void printMem(int item, int mem_ref[], int found, int size, int capacity) {
 	/*page found in memory*/ 
 	else {
 	printf("]\n"); }
+	profilePrintEnd(); 
 }
 
 	
@@ -0,0 +1,318 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "header.h"
+
+/**
+ * Implements least frequently used (LFU) page replacement policy. When a page fault occurs
+ * the page that has been referenced the fewest times since it was placed in memory is replaced,
+ * and among pages referenced equally often the one that reached that count first.
+ * Every operation takes constant time: the frames are kept in buckets, one bucket for each
+ * reference count in use, and the buckets are kept in a doubly linked list in increasing order.
+ * A referenced page moves to the next bucket, which is created if it does not exist, and the
+ * page replaced is the first one in the lowest bucket. Looking the page up is the same scan of
+ * the frames as FIFO.
+ *
+ * Counts can optionally be aged: every agePeriod references all counts are halved so pages that
+ * were popular a long time ago can be replaced. Halving keeps the buckets in order, buckets that
+ * end up with the same count are joined. **/
+
+/** A bucket holds the frames with the same reference count, oldest first. Frames and
+ * buckets are linked by their index in the arrays of the lfu struct. **/
+
+struct bucket {
+	int count;
+	int prev;     /*bucket with the next lower count*/
+	int next;     /*bucket with the next higher count*/
+	int first;    /*frame that entered the bucket first*/
+	int last;
+};
+
+struct lfu {
+	int *bucketOf;        /*bucket of each frame*/
+	int *prevFrame;       /*frames in the same bucket*/
+	int *nextFrame;
+	struct bucket *buckets;
+	int lowest;           /*bucket with the lowest count, -1 if memory is empty*/
+	int unused;           /*list of unused buckets linked by next*/
+};
+
+void printMem(int item, int mem_ref[], int found, int size, int capacity);
+static int newBucket(struct lfu *l, int count, int prev, int next);
+static void addFrame(struct lfu *l, int b, int frame);
+static void removeFrame(struct lfu *l, int frame);
+static void increment(struct lfu *l, int frame);
+static void age(struct lfu *l);
+
+/**
+ * LFU method is a driver for implementing LFU policy. It traverses the page references
+ * and determines whether there was a page hit or miss and calls the corresponding methods.
+ * int pages[] : contains memory references entered through command line.
+ * int runs[]: how many times in a row each reference occurred, NULL if every reference occurs once.
+ * char hits[]: set to 1 for each reference that was found in memory, can be NULL.
+ * pageCapacity: the number of physical memory frames.
+ * numPages: the total number of memory references.
+ * state: a flag of which process is calling LFU for printing reasons.
+ * agePeriod: number of references between halving the counts, 0 to never age. **/
+
+float LFU(int pages[], int runs[], char hits[], int pageCapacity, int numPages, int state, int agePeriod) {
+
+	/*initializing variables*/
+	int capacity = pageCapacity;
+	int size = 0;       /*pages placed in memory, keeps counting once memory is full like FIFO*/
+	float misses = 0;
+	float references = 0;
+	long long clock = 0; /*references, counts are aged every agePeriod*/
+	int i, r, frame;
+
+	/*page statistics can ask for any number of frames, so the state is not on the stack*/
+	int *mem_ref = (int*)malloc(capacity * sizeof(int));
+	int *bucketOf = (int*)malloc(capacity * sizeof(int));
+	int *prevFrame = (int*)malloc(capacity * sizeof(int));
+	int *nextFrame = (int*)malloc(capacity * sizeof(int));
+	/*a new bucket may be needed before an old one empties*/
+	struct bucket *buckets = (struct bucket *)malloc((capacity + 1) * sizeof(struct bucket));
+	struct lfu l;
+
+	if (mem_ref == NULL || bucketOf == NULL || prevFrame == NULL || nextFrame == NULL || buckets == NULL) {
+		printf("Could not allocate memory\n");
+		exit(1);
+	}
+
+	l.bucketOf = bucketOf;
+	l.prevFrame = prevFrame;
+	l.nextFrame = nextFrame;
+	l.buckets = buckets;
+	l.lowest = -1;
+
+	/*all buckets start unused*/
+	for (i = 0; i <= capacity; i++) {
+		buckets[i].next = i < capacity ? i + 1 : -1;
+	}
+	l.unused = 0;
+
+	for (i = 0; i < capacity; i++) {
+		mem_ref[i] = -1;
+	}
+
+	for (i = 0; i < numPages; i++) {
+
+		/*memory is full start counting references*/
+		if (size >= capacity) {
+			references++;
+		}
+
+		frame = findFrame(mem_ref, capacity, pages[i]);
+		if (hits != NULL) {
+			hits[i] = frame >= 0;
+		}
+
+		if (frame >= 0) {
+			increment(&l, frame);
+			if (!state) {
+				printMem(pages[i], mem_ref, 1, size, capacity);
+			}
+		}
+		else {
+			if (size < capacity) {
+				frame = size; /*next empty frame*/
+			}
+			else {
+				/*replace the first page of the lowest bucket*/
+				frame = buckets[l.lowest].first;
+				removeFrame(&l, frame);
+				misses++;
+				PROFILE_COUNT(evictions, 1);
+			}
+			mem_ref[frame] = pages[i];
+			size++;
+
+			/*a new page has been referenced once*/
+			if (l.lowest == -1 || buckets[l.lowest].count != 1) {
+				l.lowest = newBucket(&l, 1, -1, l.lowest);
+			}
+			addFrame(&l, l.lowest, frame);
+
+			if (!state) {
+				printMem(pages[i], mem_ref, 0, size, capacity);
+			}
+		}
+
+		if (agePeriod > 0 && ++clock % agePeriod == 0) {
+			age(&l);
+		}
+
+		/*collapsed repeats are hits that count as references of the page*/
+		for (r = 1; runs != NULL && r < runs[i]; r++) {
+			if (size >= capacity) {
+				references++;
+			}
+			increment(&l, frame);
+			if (agePeriod > 0 && ++clock % agePeriod == 0) {
+				age(&l);
+			}
+		}
+	}
+
+	free(mem_ref);
+	free(bucketOf);
+	free(prevFrame);
+	free(nextFrame);
+	free(buckets);
+
+	/*calculates miss rate and prints according to which method is calling LFU*/
+	float missRate = (misses/references)*100;
+
+	if (state == 0) {
+		printf("Miss rate = %0.0f / %0.0f = %0.2f%%\n", misses, references, missRate);
+	}
+	else if (state == 1) {
+		printf("LFU, %2d frames: Miss rate = %0.0f / %0.0f = %0.2f%%\n", pageCapacity, misses, references, missRate);
+	}
+
+	return missRate;
+}
+
+/**
+ * Takes an unused bucket and links it between two buckets. Returns the index of the bucket.
+ * struct lfu *l: state of the policy.
+ * int count: reference count of the bucket.
+ * int prev, next: neighbouring buckets, -1 if none. **/
+
+static int newBucket(struct lfu *l, int count, int prev, int next) {
+
+	int b = l->unused;
+	l->unused = l->buckets[b].next;
+
+	l->buckets[b].count = count;
+	l->buckets[b].prev = prev;
+	l->buckets[b].next = next;
+	l->buckets[b].first = -1;
+	l->buckets[b].last = -1;
+
+	if (prev != -1) {
+		l->buckets[prev].next = b;
+	}
+	if (next != -1) {
+		l->buckets[next].prev = b;
+	}
+	return b;
+}
+
+/**
+ * Adds a frame to the end of a bucket.
+ * struct lfu *l: state of the policy.
+ * int b: the bucket.
+ * int frame: the frame. **/
+
+static void addFrame(struct lfu *l, int b, int frame) {
+
+	struct bucket *bucket = &l->buckets[b];
+
+	l->bucketOf[frame] = b;
+	l->nextFrame[frame] = -1;
+	l->prevFrame[frame] = bucket->last;
+	if (bucket->last != -1) {
+		l->nextFrame[bucket->last] = frame;
+	}
+	else {
+		bucket->first = frame;
+	}
+	bucket->last = frame;
+}
+
+/**
+ * Removes a frame from its bucket. A bucket left empty is unlinked and becomes unused.
+ * struct lfu *l: state of the policy.
+ * int frame: the frame. **/
+
+static void removeFrame(struct lfu *l, int frame) {
+
+	int b = l->bucketOf[frame];
+	struct bucket *bucket = &l->buckets[b];
+
+	if (l->prevFrame[frame] != -1) {
+		l->nextFrame[l->prevFrame[frame]] = l->nextFrame[frame];
+	}
+	else {
+		bucket->first = l->nextFrame[frame];
+	}
+	if (l->nextFrame[frame] != -1) {
+		l->prevFrame[l->nextFrame[frame]] = l->prevFrame[frame];
+	}
+	else {
+		bucket->last = l->prevFrame[frame];
+	}
+
+	if (bucket->first != -1) {
+		return;
+	}
+
+	/*bucket is empty*/
+	if (bucket->prev != -1) {
+		l->buckets[bucket->prev].next = bucket->next;
+	}
+	else {
+		l->lowest = bucket->next;
+	}
+	if (bucket->next != -1) {
+		l->buckets[bucket->next].prev = bucket->prev;
+	}
+	bucket->next = l->unused;
+	l->unused = b;
+}
+
+/**
+ * Counts a reference of the page in a frame by moving it to the bucket with the next count.
+ * struct lfu *l: state of the policy.
+ * int frame: the frame. **/
+
+static void increment(struct lfu *l, int frame) {
+
+	int b = l->bucketOf[frame];
+	int count = l->buckets[b].count + 1;
+	int next = l->buckets[b].next;
+
+	if (next == -1 || l->buckets[next].count != count) {
+		next = newBucket(l, count, b, next);
+	}
+	removeFrame(l, frame);
+	addFrame(l, next, frame);
+}
+
+/**
+ * Halves every reference count, keeping counts at 1 or more. Buckets that end up with the
+ * same count as the bucket below are joined to it, after its frames.
+ * struct lfu *l: state of the policy. **/
+
+static void age(struct lfu *l) {
+
+	int b = l->lowest;
+
+	while (b != -1) {
+		struct bucket *bucket = &l->buckets[b];
+		int next = bucket->next;
+		int prev = bucket->prev;
+
+		bucket->count = bucket->count / 2 > 0 ? bucket->count / 2 : 1;
+
+		if (prev != -1 && l->buckets[prev].count == bucket->count) {
+			/*move the frames to the end of the bucket below*/
+			int frame = bucket->first;
+			while (frame != -1) {
+				int after = l->nextFrame[frame];
+				addFrame(l, prev, frame);
+				frame = after;
+			}
+			bucket->first = -1;
+
+			l->buckets[prev].next = next;
+			if (next != -1) {
+				l->buckets[next].prev = prev;
+			}
+			bucket->next = l->unused;
+			l->unused = b;
+		}
+		b = next;
+	}
+}
@@ -0,0 +1,227 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "header.h"
+
+/**
+ * Implements least recently/frequently used (LRFU) page replacement policy. Every page in memory
+ * has a combined recency and frequency (CRF) value: each past reference adds (1/2)^(lambda * age)
+ * where age is the number of references since it was made. When a page fault occurs the page
+ * with the smallest CRF is replaced. With lambda = 0 every reference adds 1 and LRFU is LFU,
+ * with lambda = 1 the most recent reference outweighs all older ones and LRFU is LRU.
+ *
+ * All CRF values decay at the same rate, so their order only changes when a page is referenced.
+ * The order is kept with log2(CRF at the last reference) + lambda * time of the last reference,
+ * which does not change as time passes, and the frames are kept in a heap ordered by it. **/
+
+/** State of the policy. The heap holds frame numbers, the page with the smallest CRF first. **/
+
+struct lrfu {
+	int size;          /*frames in the heap*/
+	double *crf;       /*CRF of each frame at its last reference*/
+	long long *last;   /*time of the last reference of each frame*/
+	double *key;       /*log2(crf) + lambda * last*/
+	int *heap;
+	int *pos;          /*index of each frame in the heap*/
+};
+
+void printMem(int item, int mem_ref[], int found, int size, int capacity);
+static void reference(struct lrfu *h, int frame, long long now, double lambda);
+static int before(struct lrfu *h, int a, int b);
+static void siftUp(struct lrfu *h, int i);
+static void siftDown(struct lrfu *h, int i);
+static void heapSwap(struct lrfu *h, int a, int b);
+
+/**
+ * LRFU method is a driver for implementing LRFU policy. It traverses the page references
+ * and determines whether there was a page hit or miss and calls the corresponding methods.
+ * int pages[] : contains memory references entered through command line.
+ * int runs[]: how many times in a row each reference occurred, NULL if every reference occurs once.
+ * char hits[]: set to 1 for each reference that was found in memory, can be NULL.
+ * pageCapacity: the number of physical memory frames.
+ * numPages: the total number of memory references.
+ * state: a flag of which process is calling LRFU for printing reasons.
+ * lambda: from 0 (LFU) to 1 (LRU). **/
+
+float LRFU(int pages[], int runs[], char hits[], int pageCapacity, int numPages, int state, double lambda) {
+
+	/*initializing variables*/
+	int capacity = pageCapacity;
+	int size = 0;       /*pages placed in memory, keeps counting once memory is full like FIFO*/
+	float misses = 0;
+	float references = 0;
+	long long now = 0;  /*time, one tick per reference*/
+	int i, r, frame;
+
+	/*page statistics can ask for any number of frames, so the state is not on the stack*/
+	int *mem_ref = (int*)malloc(capacity * sizeof(int));
+	int *heap = (int*)malloc(capacity * sizeof(int));
+	int *pos = (int*)malloc(capacity * sizeof(int));
+	double *crf = (double*)malloc(capacity * sizeof(double));
+	double *key = (double*)malloc(capacity * sizeof(double));
+	long long *last = (long long*)malloc(capacity * sizeof(long long));
+	struct lrfu h;
+
+	if (mem_ref == NULL || heap == NULL || pos == NULL || crf == NULL || key == NULL || last == NULL) {
+		printf("Could not allocate memory\n");
+		exit(1);
+	}
+
+	h.size = 0;
+	h.crf = crf;
+	h.last = last;
+	h.key = key;
+	h.heap = heap;
+	h.pos = pos;
+
+	for (i = 0; i < capacity; i++) {
+		mem_ref[i] = -1;
+	}
+
+	for (i = 0; i < numPages; i++) {
+
+		/*memory is full start counting references*/
+		if (size >= capacity) {
+			references++;
+		}
+
+		frame = findFrame(mem_ref, capacity, pages[i]);
+		if (hits != NULL) {
+			hits[i] = frame >= 0;
+		}
+
+		if (frame >= 0) {
+			reference(&h, frame, now, lambda);
+			if (!state) {
+				printMem(pages[i], mem_ref, 1, size, capacity);
+			}
+		}
+		else {
+			if (size < capacity) {
+				/*next empty frame goes at the end of the heap*/
+				frame = size;
+				pos[frame] = h.size;
+				heap[h.size++] = frame;
+			}
+			else {
+				/*replace the page with the smallest CRF*/
+				frame = heap[0];
+				misses++;
+				PROFILE_COUNT(evictions, 1);
+			}
+			mem_ref[frame] = pages[i];
+			size++;
+
+			/*a new page has one reference, made now*/
+			crf[frame] = 1;
+			last[frame] = now;
+			key[frame] = lambda * now;
+			siftUp(&h, pos[frame]);
+			siftDown(&h, pos[frame]);
+
+			if (!state) {
+				printMem(pages[i], mem_ref, 0, size, capacity);
+			}
+		}
+		now++;
+
+		/*collapsed repeats are hits that count as references of the page*/
+		for (r = 1; runs != NULL && r < runs[i]; r++) {
+			if (size >= capacity) {
+				references++;
+			}
+			reference(&h, frame, now, lambda);
+			now++;
+		}
+	}
+
+	free(mem_ref);
+	free(heap);
+	free(pos);
+	free(crf);
+	free(key);
+	free(last);
+
+	/*calculates miss rate and prints according to which method is calling LRFU*/
+	float missRate = (misses/references)*100;
+
+	if (state == 0) {
+		printf("Miss rate = %0.0f / %0.0f = %0.2f%%\n", misses, references, missRate);
+	}
+	else if (state == 1) {
+		printf("LRFU, %2d frames: Miss rate = %0.0f / %0.0f = %0.2f%%\n", pageCapacity, misses, references, missRate);
+	}
+
+	return missRate;
+}
+
+/**
+ * Adds a reference made now to the CRF of the page in a frame. The CRF only grows
+ * relative to the other pages, so the frame moves down the heap.
+ * struct lrfu *h: state of the policy.
+ * int frame: the frame.
+ * long long now: time of the reference.
+ * double lambda: weight of recency. **/
+
+static void reference(struct lrfu *h, int frame, long long now, double lambda) {
+
+	h->crf[frame] = 1 + h->crf[frame] * pow(2, -lambda * (now - h->last[frame]));
+	h->last[frame] = now;
+	h->key[frame] = log2(h->crf[frame]) + lambda * now;
+	siftDown(h, h->pos[frame]);
+}
+
+/** Returns 1 if frame a should be replaced before frame b: smaller CRF first,
+ * and the least recently referenced among equal CRF. **/
+
+static int before(struct lrfu *h, int a, int b) {
+
+	if (h->key[a] != h->key[b]) {
+		return h->key[a] < h->key[b];
+	}
+	return h->last[a] < h->last[b];
+}
+
+/** Moves a heap entry up while it should be replaced before its parent. **/
+
+static void siftUp(struct lrfu *h, int i) {
+
+	while (i > 0 && before(h, h->heap[i], h->heap[(i - 1) / 2])) {
+		heapSwap(h, i, (i - 1) / 2);
+		i = (i - 1) / 2;
+	}
+}
+
+/** Moves a heap entry down while a child should be replaced before it. **/
+
+static void siftDown(struct lrfu *h, int i) {
+
+	for (;;) {
+		int first = i;
+		int left = 2 * i + 1, right = 2 * i + 2;
+
+		if (left < h->size && before(h, h->heap[left], h->heap[first])) {
+			first = left;
+		}
+		if (right < h->size && before(h, h->heap[right], h->heap[first])) {
+			first = right;
+		}
+		if (first == i) {
+			return;
+		}
+		heapSwap(h, i, first);
+		i = first;
+	}
+}
+
+/** Swaps two entries of the heap. **/
+
+static void heapSwap(struct lrfu *h, int a, int b) {
+
+	int x = h->heap[a];
+	h->heap[a] = h->heap[b];
+	h->heap[b] = x;
+	h->pos[h->heap[a]] = a;
+	h->pos[h->heap[b]] = b;
+}
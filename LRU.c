@@ -1,283 +1,211 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "header.h"
 
-/**Implements least recently used (LRU) page replacement policy. The LRU policy replaces 
+/**Implements least recently used (LRU) page replacement policy. The LRU policy replaces
  * the page that has been in the memory for the longest time without having been referenced.
- * The implementation works by keeping an internal "clock" or count that increases 
- * every time memory is referenced. If a page in memory is referenced again the clock is 
- * reset to 0. When a page fault occurs the replacement method evicts the page in memory 
- * with the highest clock count. The policy is implemented using a doubly linked list. **/ 
- 
- 
-/** Each node contains the page number, an internal clock count and two pointers that
- * points to the next node and the previous node. **/ 
- 
-struct node { 
-	int page;
-	int count;  /*works like a clock, tracks how long the page has been in memory */ 
-	struct node *next;
-	struct node *previous;  
-}; 
-
-int search(struct node **head, int item); 
-void swap(struct node **head, int item);
-void addBack(struct node **head, int item, int *sizeL);
-void print(struct node **head, int item, int hit, int capacityL); 
+ * The implementation works by keeping an internal "clock" that increases every time memory
+ * is referenced. Each frame remembers the clock of the last reference of its page, and when
+ * a page fault occurs the replacement method evicts the page with the oldest last reference.
+ * The policy is implemented using an array of frames, filled in order and replaced in place,
+ * so looking up a page and finding the page to replace are the vectorized scans of scan.c. **/
+
+
+/** Physical memory of the LRU policy. The frames are filled from the front, so the
+ * first size frames are in use. **/
+
+struct lruMemory {
+	int *pages;        /*page in each frame*/
+	long long *used;   /*clock of the last reference of each frame*/
+	long long clock;   /*increases every time memory is referenced*/
+	int size;          /*number of frames in use*/
+	int capacity;
+};
+
+int search(struct lruMemory *mem, int item);
+void swap(struct lruMemory *mem, int item);
+void addBack(struct lruMemory *mem, int item);
+void print(struct lruMemory *mem, int item, int hit);
 
 
 /** LRU method is a driver for implementing LRU policy. It traverses the page references
- * and determines whether there was a page hit or miss and calls the corresponding methods. 
- * int pages[] : contains memory references entered through command line.  
- * pageCapacity: the number of physical memory frames. 
- * numPages: the total number of memory references. 
- * state: a flag of which process is calling FIFO for printing reasons.*/ 
-
-float LRU(int pages[], int pageCapacity, int numPages, int state) {
-	
-	/*initalizing variables*/ 
-	int capacityL = pageCapacity; 
-	int countL = numPages; 
-	int sizeL = 0; 
-	float missesL = 0; 
-	float referencesL = 0; 
-	int status = state; 
-	
-	int i;  
-	int found; 
-	
-	/*initialize head of doubly linked list*/ 
-	struct node *head = NULL;
-	
-	
-	for (i = 0; i < countL; i++) { 
-		
-		/*memory is full start counting references*/ 
-		if (sizeL >= capacityL) {
+ * and determines whether there was a page hit or miss and calls the corresponding methods.
+ * int pages[] : contains memory references entered through command line.
+ * int runs[]: how many times in a row each reference occurred, NULL if every reference occurs once.
+ * char hits[]: set to 1 for each reference that was found in memory, can be NULL.
+ * pageCapacity: the number of physical memory frames.
+ * numPages: the total number of memory references.
+ * state: a flag of which process is calling FIFO for printing reasons.*/
+
+float LRU(int pages[], int runs[], char hits[], int pageCapacity, int numPages, int state) {
+
+	/*initalizing variables*/
+	int capacityL = pageCapacity;
+	int countL = numPages;
+	float missesL = 0;
+	float referencesL = 0;
+	int status = state;
+
+	int i;
+	int found;
+
+	/*initialize physical memory, all frames empty. Page statistics can ask for any
+	 *number of frames, so the frames are not on the stack*/
+	struct lruMemory mem;
+
+	mem.pages = (int*)malloc(capacityL * sizeof(int));
+	mem.used = (long long*)malloc(capacityL * sizeof(long long));
+	if (mem.pages == NULL || mem.used == NULL) {
+		printf("Could not allocate memory\n");
+		exit(1);
+	}
+	mem.clock = 0;
+	mem.size = 0;
+	mem.capacity = capacityL;
+
+	for (i = 0; i < countL; i++) {
+
+		/*memory is full start counting references*/
+		if (mem.size >= capacityL) {
 			referencesL++;
 		}
-		
-		/*returns 0 if there is a page fault*/ 
-		found = search(&head, pages[i]); 
+
+		/*returns 0 if there is a page fault*/
+		found = search(&mem, pages[i]);
+		if (hits != NULL) {
+			hits[i] = found; /*record hit or fault for the caller*/
+		}
 		if (found) {
-			if (!status) {/* does not print if page stats is calling LRU*/ 
-			print(&head, pages[i], 1, capacityL);} 
+			if (!status) {/* does not print if page stats is calling LRU*/
+			print(&mem, pages[i], 1);}
 		}
 		else {
-			if (sizeL < capacityL) { /*has not yet exceeded capacity*/ 
-				/*add to the back of physical memory*/ 
-				addBack(&head, pages[i], &sizeL);
+			if (mem.size < capacityL) { /*has not yet exceeded capacity*/
+				/*add to the back of physical memory*/
+				addBack(&mem, pages[i]);
 				if (!status) {
-				print(&head, pages[i],1, capacityL);} 
+				print(&mem, pages[i], 1);}
 			}
-			else { /*page fault and memory is full*/ 
-				swap(&head, pages[i]); /*swaps out least recently used page in memory*/ 
+			else { /*page fault and memory is full*/
+				swap(&mem, pages[i]); /*swaps out least recently used page in memory*/
 				if (!status){
-				print(&head, pages[i],0, capacityL); }
-				missesL++; /*count page miss*/ 
+				print(&mem, pages[i], 0); }
+				missesL++; /*count page miss*/
 			}
 		}
+
+		/*collapsed repeats of the page are hits, count them once memory is full*/
+		if (runs != NULL && mem.size >= capacityL) {
+			referencesL += runs[i] - 1;
+		}
 	}
-	
-	
-	/*calculates miss rate and prints according to which method is calling LRU*/ 
-	
+
+
+	free(mem.pages);
+	free(mem.used);
+
+	/*calculates miss rate and prints according to which method is calling LRU*/
+
 	float missRate = (missesL/referencesL)*100;
-	
-	if (status == 0) { /*page simulation calling LRU*/ 
+
+	if (status == 0) { /*page simulation calling LRU*/
 		printf("Miss rate = %0.0f / %0.0f = %0.2f%%\n", missesL, referencesL, missRate);
 	}
-	else if (status == 1) { /*page statistics calling LRU*/ 
+	else if (status == 1) { /*page statistics calling LRU*/
 		printf("LRU, %2d frames: Miss rate = %0.0f / %0.0f = %0.2f%%\n", pageCapacity, missesL, referencesL, missRate);
-	} 
-	
-	/*returns miss rate*/ 
-	return missRate; 
+	}
+
+	/*returns miss rate*/
+	return missRate;
 }
 
-/** Traverses the content of memory to determine whether there is a page miss or hit. 
- *  It incremements the time count for each page that is currently in memory. If a page is found
- * 	it's internal clock is reset to 0. The method returns 0 if there is a page fault. 
- *  struct node **head: pointer to the head of the doubly linked list. 
- *  int item: current page being referenced*/ 
- 
-int search(struct node **head, int item) { 
-	
-	/*set flag*/ 
-	
-	int found = 0; 
-	
-	/*empty list return 0 */ 
-	if ((*head) == NULL) {
-		return found;
-	} 
-	
-	/*set current pointer to the head of the list*/ 
-	struct node *current = (*head);
-	
-	/*while there are more elements in the list*/ 
-	while (current != NULL) {
-		
-		
-		/*increment the time that the page has been in memory*/ 
-		(current->count) = (current->count) + 1; 
-		
-		if ((current->page) == item) {
-			
-			/*the page is used again reset it*/ 
-			(current->count) = 0; 
-			found = 1; /*page found*/ 
-		}
-		current = current->next; 
+/** Searches the frames in use to determine whether there is a page miss or hit.
+ * The clock advances on every reference and a page that is found gets the new clock
+ * as its last reference. The method returns 0 if there is a page fault.
+ * struct lruMemory *mem: physical memory.
+ * int item: current page being referenced*/
+
+int search(struct lruMemory *mem, int item) {
+
+	mem->clock++;
+
+	int frame = findFrame(mem->pages, mem->size, item);
+	if (frame < 0) {
+		return 0; /*page fault*/
 	}
-	return found; 
+
+	/*the page is used again*/
+	mem->used[frame] = mem->clock;
+	return 1;
 }
 
 
 /**
  * The swap method is called when there is a page fault and the memory is full. It replaces the
- * page in memory that has been least recently used in memory. The method traverses the linked list
- * to find the page that has been in memory for the longest time without having been referenced. 
- * Once the method finds the page, the new page is swapped in. 
- * struct node **head: pointer to the head of the doubly linked list. 
- * int item: current page being referenced*/ 
- 
-void swap(struct node **head, int item) {
-	
-	
-	/*empty list*/ 
-	if (head == NULL) {
-		return;  
-	} 
-	
-	/*assigns pointer to the new page that is going to be inserted*/ 
-	
-	struct node *n = (struct node *)malloc(sizeof(struct node)); 
-	
-	if (n == NULL) {
-		return; /*memory hasn't been allocated */ 
-	}
-	
-	/*start at the beginning*/ 
-	struct node *current = (*head);
-	struct node *remove = (*head);
-	
-	while ((current->next) != NULL) {
-		/*compare the count to find maximum*/  
-		if ((remove->count) < ((current->next)->count)) { 
-			/*move the remove pointer*/
-			remove = current->next; 
-		}
-		current = current->next;
-	}
-	
-	/*initialize content of the new node being added*/ 
-	(n->count) = 0; 
-	(n->page) = item;
-	
-	if ((remove->previous) != NULL) {
-		(remove -> previous)->next = n; 
-	}
-	else {
-		(*head) = n; /*change head pointer to the first element*/  
-	} 
-		
-	if ((remove->next) != NULL) {
-		(remove->next)->previous = n;
-	} 
-	
-	(n->previous) = (remove->previous);
-	(n->next) = (remove -> next); 
-	
-	/*free the page that has been removed*/ 
-	free(remove); 	
+ * page in memory that has been least recently used, the frame with the oldest last reference,
+ * with the new page in the same frame.
+ * struct lruMemory *mem: physical memory.
+ * int item: current page being referenced*/
+
+void swap(struct lruMemory *mem, int item) {
+
+	int victim = oldestFrame(mem->used, mem->size);
+	PROFILE_COUNT(evictions, 1);
+
+	mem->pages[victim] = item;
+	mem->used[victim] = mem->clock;
 }
 
-/** 
- * Add back method is called when there is a page fault by memory content is not yet full. 
- * The method adds the new page to the back of the linked list and increases the size
- * of the pages in physical memory. 
- * struct node **head: pointer to the beginning of the doubly linked list. 
- * int item: current page being referenced. 
- * int *sizeL: keeps track of the how many pages are currently in memory. **/ 
- 
-void addBack(struct node **head, int item, int *sizeL) {
-	
-	/*new page to be added to the linked list*/ 
-	struct node *n = (struct node *)malloc(sizeof(struct node)); 
-	
-	if (n == NULL) {
-		return; 
-	}
-	
-	/*adding the first item*/ 
-	if ((*head) == NULL) { 
-		(n->next) = (*head); 
-		(*head) = n; 
-		(n->page) = item;
-		(n->count) = 0; /*set count to 0*/ 
-		(n->next) = NULL;
-		(n->previous) = NULL; 	
-	} 
-	else {
-		
-		/*traverses to the back of the list*/ 
-		struct node *current = (*head);
-		while ((current->next) != NULL) {
-			current = current->next;
-		}
-		/*initilized content of the new page*/ 
-		(n->page) = item; 
-		(n->count) = 0; /*set count to 0*/ 
-		(current->next) = n;
-		(n->previous) = current; 
-		(n->next) = NULL;  
-	} 
-	/*increment size by one*/ 
-	*sizeL = (*sizeL) + 1;
+/**
+ * Add back method is called when there is a page fault by memory content is not yet full.
+ * The method places the new page in the next empty frame and increases the size
+ * of the pages in physical memory.
+ * struct lruMemory *mem: physical memory.
+ * int item: current page being referenced. **/
+
+void addBack(struct lruMemory *mem, int item) {
+
+	mem->pages[mem->size] = item;
+	mem->used[mem->size] = mem->clock;
+
+	/*increment size by one*/
+	mem->size++;
 }
 
-/**Print the current content of physical memory depending on whether there 
- * was a page hit or miss. 
- * struct **head: pointer to the beginning of the doubly linked list. 
- * int teim: current item being referenced. 
- * int hit: flag that indicates wheter there was a hit or a miss. 
- * int capacityL: capacity of physical memory. **/ 
- 
-void print(struct node **head, int item, int hit, int capacityL) {
-	
-	/*nothing to print*/ 
-	if ((*head) == NULL) {
-		return; 
-	} 
-	 
-	int i = 0; 
-	printf("%2d: [", item); 
-	
-	/*start at the begnning of the list*/ 
-	struct node* current = (*head); 
-	
-	/*prints memory content*/ 
-	while (current != NULL) {
-		printf("%2d|", current->page); 
-		current = current->next; 
-		i++;
-	} 
-	
-	/*if size is less than capacity print empty content of memory*/ 
-	while (i < capacityL) {
-		printf("%2s|",""); 
+/**Print the current content of physical memory depending on whether there
+ * was a page hit or miss.
+ * struct lruMemory *mem: physical memory.
+ * int item: current item being referenced.
+ * int hit: flag that indicates wheter there was a hit or a miss. **/
+
+void print(struct lruMemory *mem, int item, int hit) {
+
+	/*nothing to print*/
+	if (mem->size == 0) {
+		return;
+	}
+
+	int i = 0;
+	profilePrintStart();
+	printf("%2d: [", item);
+
+	/*prints memory content*/
+	for (i = 0; i < mem->size; i++) {
+		printf("%2d|", mem->pages[i]);
+	}
+
+	/*if size is less than capacity print empty content of memory*/
+	while (i < mem->capacity) {
+		printf("%2s|","");
 		i++;
 	}
-	/*page fault*/ 
+	/*page fault*/
 	if (!hit) {
 		printf("]  F\n"); }
-	
-	/*page hit*/ 
+
+	/*page hit*/
 	else {
 		printf("]\n"); }
+	profilePrintEnd();
 }
-
-
-
-
@@ -1,12 +1,139 @@
 
 /**Three different page replacement policies called by page simulation and 
  * page statistics. FIFO implements the first in first out policy, LRU implements
- * least recently used and the extra method implements the random place replacement policy*/ 
+ * least recently used and the extra method implements the random place replacement policy.
+ * state 0 prints memory for page simulation, state 1 prints the miss rate for page statistics
+ * and any other state prints nothing*/ 
 
-float FIFO(int pages[], int pageCapacity, int numPages, int state); 
-float LRU(int pages[], int pageCapacity, int numPages, int state); 
-float extra(int pages[], int numCapacity, int numPages, int state); 
+float FIFO(int pages[], int runs[], char hits[], int pageCapacity, int numPages, int state); 
+float LRU(int pages[], int runs[], char hits[], int pageCapacity, int numPages, int state); 
+float extra(int pages[], int runs[], char hits[], int numCapacity, int numPages, int state); 
 
+/**Frequency based policies. LFU replaces the page referenced the fewest times, optionally 
+ * halving the counts every agePeriod references. LRFU replaces the page with the smallest 
+ * combined recency and frequency, lambda goes from 0 (LFU) to 1 (LRU)*/ 
 
+#define LRFU_LAMBDA 0.1   /*lambda used by page statistics and when none is given*/
 
+float LFU(int pages[], int runs[], char hits[], int pageCapacity, int numPages, int state, int agePeriod); 
+float LRFU(int pages[], int runs[], char hits[], int pageCapacity, int numPages, int state, double lambda); 
 
+/**Trace preprocessing used by page statistics. Consecutive references to the same page
+ * are collapsed into one reference with a run length, see trace.c*/ 
+
+int *readTrace(char *fileName, int *count); 
+int *readTraceTail(char *fileName, long long skip, int *count); 
+int collapseTrace(int pages[], int runs[], int count, int *numDistinct); 
+int renumberTrace(int pages[], int n); 
+int loadTrace(char *fileName, int **pages, int **runs, int *count);
+
+/**Random numbers with a state of their own, the sequence random() gives with glibc, see random.c*/ 
+
+#define RANDOM_DEGREE 31     /*words of state, the default of srandom()*/
+#define RANDOM_SEPARATION 3  /*distance between the two words that are added*/
+
+struct randomState {
+	unsigned int table[RANDOM_DEGREE];
+	int front;         /*word that is added to and returned*/
+	int rear;
+};
+
+void seedRandom(struct randomState *r, unsigned int seed); 
+int nextRandom(struct randomState *r); 
+
+/**Memory hierarchy used by page tiers. Each tier has its own frames, latency and
+ * replacement policy, see tier.c*/ 
+
+#define FIFO_POLICY 0
+#define LRU_POLICY 1
+#define RANDOM_POLICY 2
+#define GDSF_POLICY 3
+#define LFU_POLICY 4
+#define LRFU_POLICY 5
+
+struct frames {
+	int policy;
+	int capacity;
+	int size;          /*number of frames in use*/
+	long long clock;   /*increases every time the frames are referenced*/
+	int *pages;        /*page in each frame, -1 if empty*/
+	long long *time;   /*when each page was placed in memory, or last used for LRU*/
+	struct randomState *random;  /*state for RANDOM_POLICY, NULL to use random()*/
+};
+
+struct tier {
+	char *name;
+	double latency;    /*cost of a hit in this tier*/
+	struct frames *frames;
+	long long hits;
+	long long promotions;  /*pages moved up out of this tier*/
+	long long demotions;   /*pages moved down out of this tier*/
+	long long evictions;   /*pages that left memory, only the last tier evicts*/
+};
+
+struct frames *newFrames(int policy, int capacity); 
+void freeFrames(struct frames *f); 
+int findPage(struct frames *f, int page); 
+int placePage(struct frames *f, int page); 
+void removePage(struct frames *f, int index); 
+int accessTiers(struct tier tiers[], int numTiers, int page);
+
+/**Scans of the frames of physical memory, vectorized where the processor allows, see scan.c*/ 
+
+int findFrame(const int frames[], int capacity, int page); 
+int oldestFrame(const long long time[], int capacity);
+
+/**Cache of objects of different sizes with a capacity in bytes, see objects.c*/ 
+
+struct objectStats {
+	long long references;
+	long long misses;
+	long long bytes;         /*bytes referenced*/
+	long long missedBytes;   /*bytes of the references that missed*/
+};
+
+int readObjects(char *fileName, int **ids, int **sizes, double **costs, int *count); 
+int simulateObjects(int policy, int ids[], int sizes[], double costs[], int count, int numDistinct, 
+		long long capacity, struct objectStats *stats);
+
+/**Set associative memory used by page sets. Pages map to a set by a hash of the page number
+ * or by its color, the page number modulo the number of sets, and each set is a small memory
+ * with its own replacement policy, see sets.c*/ 
+
+#define SET_HASH 0
+#define SET_COLOR 1
+
+struct sets {
+	int numSets;
+	int ways;          /*frames in each set*/
+	int *pages;        /*references of each set one after the other, collapsed*/
+	int *runs;
+	int *start;        /*index of the first reference of each set*/
+	int *length;       /*number of references of each set after collapsing*/
+};
+
+struct sets *newSets(int pages[], int count, int numSets, int ways, int mapping); 
+void freeSets(struct sets *s); 
+int simulateSets(struct sets *s, int policy, int threads, long long *misses, long long *references);
+
+/**Profiling turned on with --profile, see profile.c. The policies count their operations 
+ * with PROFILE_COUNT, which does nothing unless profiling is on, and time printing memory
+ * between profilePrintStart and profilePrintEnd*/ 
+
+struct profileCounts {
+	long long lookups;       /*searches for a page in memory*/
+	long long probes;        /*frames examined by those searches*/
+	long long victimScans;   /*frames examined choosing the page to replace*/
+	long long evictions;
+};
+
+extern int profiling; 
+extern struct profileCounts profileCounts; 
+
+#define PROFILE_COUNT(field, n) do { if (profiling) profileCounts.field += (n); } while (0)
+
+void profileOption(int *argc, char *argv[]); 
+void profilePhase(const char *name); 
+void profileReport(void); 
+void profilePrintStart(void); 
+void profilePrintEnd(void); 
@@ -0,0 +1,266 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "header.h"
+#include "libpagesim.h"
+
+/**
+ * Implements the library interface on top of the frames used by page tiers. The frames
+ * are filled in order and FIFO and LRU replace the page with the oldest time, which gives the
+ * same hits and faults as the FIFO and LRU methods. Each simulator has its own random state,
+ * see random.c, so simulators never touch the random() state of the caller or of each other and
+ * can be used from different threads, and with glibc a simulator seeded with 1 replaces the same
+ * frames as extra. Because the state is kept in the simulator it can be copied into a fork or a
+ * snapshot file. **/
+
+#define SNAPSHOT_MAGIC 0x33534e53 /*"SNS3"*/
+
+struct pagesim {
+	struct frames *frames;
+	struct randomState random;   /*random state of this simulator*/
+	struct pagesim_stats stats;
+};
+
+/** Header of a snapshot file, followed by the pages and times of the frames. **/
+
+struct snapshot {
+	int magic;
+	int policy;
+	int capacity;
+	int size;
+	long long clock;
+	struct randomState random;
+	struct pagesim_stats stats;
+};
+
+static struct pagesim *newSim(int policy, int frames, unsigned int seed);
+
+/**
+ * Creates a simulator with all frames empty. Returns NULL if the policy is not fifo, lru or
+ * extra, the number of frames is less than 1 or memory cannot be allocated.
+ * const char *policy: "fifo", "lru" or "extra" as for page simulation.
+ * int frames: number of physical memory frames.
+ * const struct pagesim_opts *opts: options, can be NULL. **/
+
+struct pagesim *pagesim_create(const char *policy, int frames, const struct pagesim_opts *opts) {
+
+	int method;
+
+	if (policy == NULL || frames < 1) {
+		return NULL;
+	}
+	if (strcmp(policy, "fifo") == 0) {
+		method = FIFO_POLICY;
+	}
+	else if (strcmp(policy, "lru") == 0) {
+		method = LRU_POLICY;
+	}
+	else if (strcmp(policy, "extra") == 0) {
+		method = RANDOM_POLICY;
+	}
+	else {
+		return NULL;
+	}
+
+	return newSim(method, frames, opts != NULL ? opts->seed : 1);
+}
+
+/**
+ * References a batch of pages in order. Returns the number of hits in the batch.
+ * struct pagesim *sim: the simulator.
+ * const int *pages: page references.
+ * int n: number of page references.
+ * char *out_hits: set to 1 for each reference that was found in memory, can be NULL. **/
+
+int pagesim_access_batch(struct pagesim *sim, const int *pages, int n, char *out_hits) {
+
+	struct frames *f = sim->frames;
+	int i, hits = 0;
+	long long references = 0, misses = 0;
+
+	for (i = 0; i < n; i++) {
+		int full = f->size >= f->capacity;
+		int hit = findPage(f, pages[i]) >= 0;
+
+		if (!hit) {
+			placePage(f, pages[i]);
+			misses += full;
+		}
+		references += full;
+		hits += hit;
+		if (out_hits != NULL) {
+			out_hits[i] = hit;
+		}
+	}
+
+	sim->stats.accesses += n;
+	sim->stats.hits += hits;
+	sim->stats.faults += n - hits;
+	sim->stats.references += references;
+	sim->stats.misses += misses;
+	return hits;
+}
+
+/**
+ * Copies the counters of a simulator.
+ * const struct pagesim *sim: the simulator.
+ * struct pagesim_stats *stats: set to the counters. **/
+
+void pagesim_stats(const struct pagesim *sim, struct pagesim_stats *stats) {
+
+	/*computed in float like the policies so the rates are identical*/
+	float misses = sim->stats.misses;
+	float references = sim->stats.references;
+	float missRate = (misses/references)*100;
+
+	*stats = sim->stats;
+	stats->missRate = missRate;
+}
+
+/** Frees a simulator.
+ * struct pagesim *sim: the simulator, can be NULL. **/
+
+void pagesim_destroy(struct pagesim *sim) {
+
+	if (sim == NULL) {
+		return;
+	}
+	freeFrames(sim->frames);
+	free(sim);
+}
+
+/**
+ * Copies a simulator so that several continuations can be run from the same state.
+ * Returns NULL if memory cannot be allocated.
+ * const struct pagesim *sim: the simulator to copy. **/
+
+struct pagesim *pagesim_fork(const struct pagesim *sim) {
+
+	struct frames *f = sim->frames;
+	struct pagesim *copy = newSim(f->policy, f->capacity, 1);
+	if (copy == NULL) {
+		return NULL;
+	}
+
+	copy->frames->size = f->size;
+	copy->frames->clock = f->clock;
+	memcpy(copy->frames->pages, f->pages, f->capacity * sizeof(int));
+	memcpy(copy->frames->time, f->time, f->capacity * sizeof(long long));
+
+	copy->random = sim->random;
+	copy->stats = sim->stats;
+	return copy;
+}
+
+/**
+ * Writes the full state of a simulator to a file. Returns 0 if the file cannot be written.
+ * const struct pagesim *sim: the simulator.
+ * const char *fileName: name of the snapshot file. **/
+
+int pagesim_save(const struct pagesim *sim, const char *fileName) {
+
+	struct frames *f = sim->frames;
+	struct snapshot head;
+
+	FILE *file = fopen(fileName, "wb");
+	if (file == NULL) {
+		return 0;
+	}
+
+	memset(&head, 0, sizeof(head));
+	head.magic = SNAPSHOT_MAGIC;
+	head.policy = f->policy;
+	head.capacity = f->capacity;
+	head.size = f->size;
+	head.clock = f->clock;
+	head.random = sim->random;
+	head.stats = sim->stats;
+
+	int ok = fwrite(&head, sizeof(head), 1, file) == 1
+		&& fwrite(f->pages, sizeof(int), f->capacity, file) == (size_t)f->capacity
+		&& fwrite(f->time, sizeof(long long), f->capacity, file) == (size_t)f->capacity;
+
+	if (fclose(file) != 0 || !ok) {
+		remove(fileName); /*do not leave a partial snapshot behind*/
+		return 0;
+	}
+	return 1;
+}
+
+/**
+ * Restores a simulator from a snapshot file. Returns NULL if the file cannot be read
+ * or is not a snapshot.
+ * const char *fileName: name of the snapshot file. **/
+
+struct pagesim *pagesim_load(const char *fileName) {
+
+	struct snapshot head;
+
+	FILE *file = fopen(fileName, "rb");
+	if (file == NULL) {
+		return NULL;
+	}
+
+	if (fread(&head, sizeof(head), 1, file) != 1 || head.magic != SNAPSHOT_MAGIC
+			|| head.policy < FIFO_POLICY || head.policy > RANDOM_POLICY
+			|| head.capacity < 1 || head.size < 0 || head.size > head.capacity
+			|| head.random.front < 0 || head.random.front >= RANDOM_DEGREE
+			|| head.random.rear < 0 || head.random.rear >= RANDOM_DEGREE) {
+		fclose(file);
+		return NULL;
+	}
+
+	struct pagesim *sim = newSim(head.policy, head.capacity, 1);
+	if (sim == NULL) {
+		fclose(file);
+		return NULL;
+	}
+
+	struct frames *f = sim->frames;
+	if (fread(f->pages, sizeof(int), f->capacity, file) != (size_t)f->capacity
+			|| fread(f->time, sizeof(long long), f->capacity, file) != (size_t)f->capacity) {
+		pagesim_destroy(sim);
+		fclose(file);
+		return NULL;
+	}
+	fclose(file);
+
+	sim->random = head.random;
+
+	/*the size is counted from the frames, a size that does not match them would let
+	 *placePage look for an empty frame in full memory*/
+	int i;
+	f->size = 0;
+	for (i = 0; i < f->capacity; i++) {
+		f->size += f->pages[i] != -1;
+	}
+	f->clock = head.clock;
+	sim->stats = head.stats;
+	return sim;
+}
+
+/**
+ * Allocates a simulator with empty frames and zero counters. Returns NULL if memory
+ * cannot be allocated.
+ * int policy: FIFO_POLICY, LRU_POLICY or RANDOM_POLICY.
+ * int frames: number of physical memory frames.
+ * unsigned int seed: seed of the random state. **/
+
+static struct pagesim *newSim(int policy, int frames, unsigned int seed) {
+
+	struct pagesim *sim = (struct pagesim *)malloc(sizeof(struct pagesim));
+	if (sim == NULL) {
+		return NULL;
+	}
+
+	sim->frames = newFrames(policy, frames);
+	if (sim->frames == NULL) {
+		free(sim);
+		return NULL;
+	}
+	memset(&sim->stats, 0, sizeof(sim->stats));
+
+	seedRandom(&sim->random, seed);
+	sim->frames->random = &sim->random;
+	return sim;
+}
@@ -0,0 +1,44 @@
+#ifndef LIBPAGESIM_H
+#define LIBPAGESIM_H
+
+/**Library interface to the page replacement policies for programs that produce their own
+ * page references, such as trace collectors and cache sizing controllers. A simulator is
+ * created for one policy and number of frames and is then fed batches of page references.
+ * Nothing is printed. Page numbers must be greater or equal to 0. Build the library with
+ * make libpagesim.a and link with libpagesim.a -lm -lpthread. Simulators are independent and
+ * can be used from different threads, one thread per simulator at a time. */
+
+struct pagesim;
+
+/**Options for pagesim_create, NULL uses the defaults*/
+
+struct pagesim_opts {
+	unsigned int seed;   /*seed for the random policy, the default is 1 like random()*/
+};
+
+/**Counters since the simulator was created. references and misses are counted once memory
+ * is full, the same way as page simulation and page statistics, so missRate matches them*/
+
+struct pagesim_stats {
+	long long accesses;     /*every page reference*/
+	long long hits;         /*references found in memory*/
+	long long faults;       /*references not found in memory*/
+	long long references;   /*references made once memory is full*/
+	long long misses;       /*faults once memory is full*/
+	double missRate;        /*misses / references * 100*/
+};
+
+struct pagesim *pagesim_create(const char *policy, int frames, const struct pagesim_opts *opts);
+int pagesim_access_batch(struct pagesim *sim, const int *pages, int n, char *out_hits);
+void pagesim_stats(const struct pagesim *sim, struct pagesim_stats *stats);
+void pagesim_destroy(struct pagesim *sim);
+
+/**Snapshots of the full state of a simulator: frames, replacement order, counters and random
+ * state. A simulator restored from a snapshot continues exactly where the saved one stopped,
+ * stats.accesses tells how many references it has already seen*/
+
+struct pagesim *pagesim_fork(const struct pagesim *sim);
+int pagesim_save(const struct pagesim *sim, const char *fileName);
+struct pagesim *pagesim_load(const char *fileName);
+
+#endif
@@ -0,0 +1,395 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "header.h"
+
+/**
+ * Simulates a cache of objects of different sizes whose capacity is counted in bytes instead
+ * of frames. Each line of an object trace is an object number, optionally followed by its size
+ * in bytes (1 if not given) and the cost of missing it (1 if not given), so a page trace is an
+ * object trace where every object takes one byte. When an object does not fit, objects are
+ * evicted until it does; an object larger than the whole cache is never placed in it. A reference
+ * whose size differs from the copy in the cache finds a stale copy: it is a miss, the old copy is
+ * dropped and the object is placed again at its new size.
+ *
+ * FIFO and LRU keep the objects in a doubly linked list, random keeps them in an array and picks
+ * one with random(), and GreedyDual-Size-Frequency (GDSF) keeps them in a heap ordered by
+ * priority L + frequency * cost / size, where L is the priority of the last object evicted.
+ * Objects are renumbered densely so the state of each object is kept in arrays indexed by
+ * its number. **/
+
+/** State of an object cache. Lists and the heap hold object numbers. **/
+
+struct objectCache {
+	int policy;
+	long long capacity;
+	long long used;      /*bytes in the cache*/
+	int count;           /*objects in the cache*/
+	char *resident;      /*1 for each object in the cache*/
+	int *size;           /*size of each object when it was placed in the cache*/
+	int *prev;           /*FIFO and LRU list, most recent first*/
+	int *next;
+	int head;
+	int tail;
+	int *slot;           /*random: index in objects, GDSF: index in the heap*/
+	int *objects;        /*random: objects in the cache, GDSF: heap*/
+	int *freq;           /*GDSF: references since the object was placed*/
+	double *priority;    /*GDSF: priority of each object*/
+	double inflation;    /*GDSF: L, priority of the last evicted object*/
+};
+
+static int newCache(struct objectCache *c, int policy, long long capacity, int numDistinct);
+static void freeCache(struct objectCache *c);
+static void hit(struct objectCache *c, int id, double cost);
+static void evict(struct objectCache *c);
+static void removeObject(struct objectCache *c, int id);
+static void admit(struct objectCache *c, int id, int size, double cost);
+static void listRemove(struct objectCache *c, int id);
+static void pushFront(struct objectCache *c, int id);
+static void heapSwap(struct objectCache *c, int a, int b);
+static void heapUp(struct objectCache *c, int i);
+static void heapDown(struct objectCache *c, int i);
+
+/**
+ * Reads an object trace. Returns 0 if the file cannot be opened, memory cannot be allocated
+ * or a size is less than 1.
+ * char *fileName: name of the trace file.
+ * int **ids: set to the object numbers.
+ * int **sizes: set to the size of each reference in bytes.
+ * double **costs: set to the miss cost of each reference.
+ * int *count: set to the number of references. **/
+
+int readObjects(char *fileName, int **ids, int **sizes, double **costs, int *count) {
+
+	FILE *file = fopen(fileName, "r");
+	if (file == NULL) {
+		return 0;
+	}
+
+	char line[256];
+	int maxSize = 1000, n = 0;
+	int *id = (int*)malloc(maxSize * sizeof(int));
+	int *size = (int*)malloc(maxSize * sizeof(int));
+	double *cost = (double*)malloc(maxSize * sizeof(double));
+
+	while (id != NULL && size != NULL && cost != NULL && fgets(line, sizeof(line), file) != NULL) {
+		int object, bytes = 1;
+		double missCost = 1;
+
+		if (sscanf(line, "%d %d %lf", &object, &bytes, &missCost) < 1) {
+			continue; /*blank line*/
+		}
+		if (bytes < 1) {
+			n = -1;
+			break;
+		}
+
+		/*arrays are full, double their size*/
+		if (n == maxSize) {
+			maxSize = maxSize * 2;
+			int *a = (int*)realloc(id, maxSize * sizeof(int));
+			int *b = (int*)realloc(size, maxSize * sizeof(int));
+			double *c = (double*)realloc(cost, maxSize * sizeof(double));
+			id = a != NULL ? a : id;
+			size = b != NULL ? b : size;
+			cost = c != NULL ? c : cost;
+			if (a == NULL || b == NULL || c == NULL) {
+				n = -1;
+				break;
+			}
+		}
+
+		id[n] = object;
+		size[n] = bytes;
+		cost[n] = missCost;
+		n++;
+	}
+
+	fclose(file);
+
+	if (id == NULL || size == NULL || cost == NULL || n < 0) {
+		free(id);
+		free(size);
+		free(cost);
+		return 0;
+	}
+
+	*ids = id;
+	*sizes = size;
+	*costs = cost;
+	*count = n;
+	return 1;
+}
+
+/**
+ * Runs an object trace through a cache of the given number of bytes. Returns 0 if memory
+ * cannot be allocated.
+ * int policy: FIFO_POLICY, LRU_POLICY, RANDOM_POLICY or GDSF_POLICY.
+ * int ids[]: object numbers renumbered densely from 0.
+ * int sizes[]: size of each reference in bytes.
+ * double costs[]: miss cost of each reference.
+ * int count: number of references.
+ * int numDistinct: number of distinct objects.
+ * long long capacity: size of the cache in bytes.
+ * struct objectStats *stats: set to the references and misses, counted and in bytes. **/
+
+int simulateObjects(int policy, int ids[], int sizes[], double costs[], int count, int numDistinct,
+		long long capacity, struct objectStats *stats) {
+
+	struct objectCache c;
+	int i;
+
+	if (!newCache(&c, policy, capacity, numDistinct)) {
+		return 0;
+	}
+	memset(stats, 0, sizeof(*stats));
+
+	for (i = 0; i < count; i++) {
+		int id = ids[i];
+
+		stats->references++;
+		stats->bytes += sizes[i];
+
+		if (c.resident[id] && c.size[id] == sizes[i]) {
+			hit(&c, id, costs[i]);
+			continue;
+		}
+
+		/*the copy in the cache has another size, it is stale*/
+		if (c.resident[id]) {
+			removeObject(&c, id);
+		}
+
+		/*object fault*/
+		stats->misses++;
+		stats->missedBytes += sizes[i];
+
+		if (sizes[i] > capacity) {
+			continue; /*can never fit*/
+		}
+		while (c.used + sizes[i] > capacity) {
+			evict(&c);
+		}
+		admit(&c, id, sizes[i], costs[i]);
+	}
+
+	freeCache(&c);
+	return 1;
+}
+
+/** Allocates the state of an empty cache, returns 0 if memory cannot be allocated. **/
+
+static int newCache(struct objectCache *c, int policy, long long capacity, int numDistinct) {
+
+	int n = numDistinct > 0 ? numDistinct : 1;
+
+	memset(c, 0, sizeof(*c));
+	c->policy = policy;
+	c->capacity = capacity;
+	c->head = -1;
+	c->tail = -1;
+	c->resident = (char*)calloc(n, 1);
+	c->size = (int*)malloc(n * sizeof(int));
+	c->prev = (int*)malloc(n * sizeof(int));
+	c->next = (int*)malloc(n * sizeof(int));
+	c->slot = (int*)malloc(n * sizeof(int));
+	c->objects = (int*)malloc(n * sizeof(int));
+	c->freq = (int*)malloc(n * sizeof(int));
+	c->priority = (double*)malloc(n * sizeof(double));
+
+	if (c->resident == NULL || c->size == NULL || c->prev == NULL || c->next == NULL || c->slot == NULL
+			|| c->objects == NULL || c->freq == NULL || c->priority == NULL) {
+		freeCache(c);
+		return 0;
+	}
+	return 1;
+}
+
+/** Frees the state of a cache. **/
+
+static void freeCache(struct objectCache *c) {
+
+	free(c->resident);
+	free(c->size);
+	free(c->prev);
+	free(c->next);
+	free(c->slot);
+	free(c->objects);
+	free(c->freq);
+	free(c->priority);
+}
+
+/** Updates the cache for a reference to an object that is in it. **/
+
+static void hit(struct objectCache *c, int id, double cost) {
+
+	if (c->policy == LRU_POLICY) {
+		/*most recently used goes to the front*/
+		listRemove(c, id);
+		pushFront(c, id);
+	}
+	else if (c->policy == GDSF_POLICY) {
+		c->freq[id]++;
+		c->priority[id] = c->inflation + c->freq[id] * cost / c->size[id];
+		/*the cost of this reference can be lower than before, so the priority can move either way*/
+		heapUp(c, c->slot[id]);
+		heapDown(c, c->slot[id]);
+	}
+}
+
+/** Evicts one object chosen by the policy. The cache must not be empty. **/
+
+static void evict(struct objectCache *c) {
+
+	int victim;
+
+	if (c->policy == RANDOM_POLICY) {
+		victim = c->objects[random() % c->count];
+	}
+	else if (c->policy == GDSF_POLICY) {
+		/*lowest priority is at the top of the heap*/
+		victim = c->objects[0];
+		c->inflation = c->priority[victim];
+	}
+	else {
+		/*FIFO and LRU both evict the back of the list*/
+		victim = c->tail;
+	}
+
+	removeObject(c, victim);
+	PROFILE_COUNT(evictions, 1);
+}
+
+/** Takes an object that is in the cache out of it. **/
+
+static void removeObject(struct objectCache *c, int id) {
+
+	c->count--;
+
+	if (c->policy == RANDOM_POLICY) {
+		/*move the last object into the hole*/
+		int i = c->slot[id];
+		c->objects[i] = c->objects[c->count];
+		c->slot[c->objects[i]] = i;
+	}
+	else if (c->policy == GDSF_POLICY) {
+		/*move the last entry into the hole, it can belong above or below it*/
+		int i = c->slot[id];
+		heapSwap(c, i, c->count);
+		if (i < c->count) {
+			heapUp(c, i);
+			heapDown(c, i);
+		}
+	}
+	else {
+		listRemove(c, id);
+	}
+
+	c->resident[id] = 0;
+	c->used -= c->size[id];
+}
+
+/** Places an object in the cache, there must be room for it. **/
+
+static void admit(struct objectCache *c, int id, int size, double cost) {
+
+	c->resident[id] = 1;
+	c->size[id] = size;
+	c->used += size;
+
+	if (c->policy == RANDOM_POLICY) {
+		c->slot[id] = c->count;
+		c->objects[c->count] = id;
+	}
+	else if (c->policy == GDSF_POLICY) {
+		c->freq[id] = 1;
+		c->priority[id] = c->inflation + cost / size;
+		c->slot[id] = c->count;
+		c->objects[c->count] = id;
+		heapUp(c, c->count);
+	}
+	else {
+		pushFront(c, id);
+	}
+	c->count++;
+}
+
+/** Removes an object from the FIFO and LRU list. **/
+
+static void listRemove(struct objectCache *c, int id) {
+
+	if (c->prev[id] != -1) {
+		c->next[c->prev[id]] = c->next[id];
+	}
+	else {
+		c->head = c->next[id];
+	}
+	if (c->next[id] != -1) {
+		c->prev[c->next[id]] = c->prev[id];
+	}
+	else {
+		c->tail = c->prev[id];
+	}
+}
+
+/** Adds an object to the front of the FIFO and LRU list. **/
+
+static void pushFront(struct objectCache *c, int id) {
+
+	c->prev[id] = -1;
+	c->next[id] = c->head;
+	if (c->head != -1) {
+		c->prev[c->head] = id;
+	}
+	else {
+		c->tail = id;
+	}
+	c->head = id;
+}
+
+/** Swaps two entries of the GDSF heap. **/
+
+static void heapSwap(struct objectCache *c, int a, int b) {
+
+	int x = c->objects[a];
+	c->objects[a] = c->objects[b];
+	c->objects[b] = x;
+	c->slot[c->objects[a]] = a;
+	c->slot[c->objects[b]] = b;
+}
+
+/** Moves a heap entry up while its priority is lower than its parent's. **/
+
+static void heapUp(struct objectCache *c, int i) {
+
+	while (i > 0) {
+		int parent = (i - 1) / 2;
+		if (c->priority[c->objects[parent]] <= c->priority[c->objects[i]]) {
+			break;
+		}
+		heapSwap(c, i, parent);
+		i = parent;
+	}
+}
+
+/** Moves a heap entry down while a child has a lower priority. **/
+
+static void heapDown(struct objectCache *c, int i) {
+
+	for (;;) {
+		int smallest = i;
+		int left = 2 * i + 1, right = 2 * i + 2;
+
+		if (left < c->count && c->priority[c->objects[left]] < c->priority[c->objects[smallest]]) {
+			smallest = left;
+		}
+		if (right < c->count && c->priority[c->objects[right]] < c->priority[c->objects[smallest]]) {
+			smallest = right;
+		}
+		if (smallest == i) {
+			return;
+		}
+		heapSwap(c, i, smallest);
+		i = smallest;
+	}
+}
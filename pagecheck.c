@@ -0,0 +1,993 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "header.h"
+#include "libpagesim.h"
+
+/**
+ * Page check verifies the page replacement policies against simple reference implementations
+ * and checks that they have not become slower. Every policy is run on generated traces and on the
+ * trace files given on the command line, with every number of physical memory frames from 1 to 100,
+ * and the hit or fault of each reference and the miss rate are compared with the reference
+ * implementation. Each trace is checked as it is, with consecutive repeats collapsed the way page
+ * statistics runs it and through the library interface in batches. The random policy is seeded the
+ * same way for every implementation. A trace file may have golden results next to it, in a file
+ * named after the trace with .golden added, holding the misses, references and a hash of the hits
+ * of every policy and number of frames, so a change to a reference implementation is caught too.
+ *
+ * The throughput of each policy on a fixed generated trace is then measured as a ratio to the
+ * throughput of its reference implementation on the same trace, so the result does not depend on how
+ * fast the machine is, and compared with the ratios in the baseline file. Page check exits with 1 if
+ * any reference differs, a golden result or the baseline is missing, or a policy is more than
+ * REGRESSION slower than its baseline. With --record the golden results of the trace files and the
+ * baseline are written instead of checked.
+ *
+ * The object cache of page objects is checked on short traces whose objects change size, where the
+ * number of misses is known, and FIFO and LRU are compared with a reference object cache on a
+ * generated trace of objects of changing sizes. The random policy of page sets must give the same
+ * result on any number of threads, and a single set must replace the same frames as extra. **/
+
+#define MAX_FRAMES 100      /*largest number of frames page simulation allows*/
+#define SEED 1              /*seed for the random policy*/
+#define REGRESSION 0.25     /*allowed drop in throughput*/
+#define BENCH_PAGES 100000  /*length of the timed trace*/
+#define BENCH_RUNS 7        /*the best of this many runs is kept*/
+#define AGE_PERIOD 64        /*references between halving the counts of aged LFU*/
+#define POLICIES 6
+#define OBJECTS 50          /*distinct objects of the generated object trace*/
+
+typedef float (*policy)(int pages[], int runs[], char hits[], int pageCapacity, int numPages, int state);
+
+float refFIFO(int pages[], char hits[], int capacity, int count);
+float refLRU(int pages[], char hits[], int capacity, int count);
+float refRandom(int pages[], char hits[], int capacity, int count);
+float refLFU(int pages[], char hits[], int capacity, int count);
+float refLRFU(int pages[], char hits[], int capacity, int count);
+float refAgedLFU(int pages[], char hits[], int capacity, int count);
+float runLFU(int pages[], int runs[], char hits[], int pageCapacity, int numPages, int state);
+float runLRFU(int pages[], int runs[], char hits[], int pageCapacity, int numPages, int state);
+float runAgedLFU(int pages[], int runs[], char hits[], int pageCapacity, int numPages, int state);
+int checkTrace(char *name, int pages[], int count, FILE *golden, int record);
+int checkGolden(FILE *golden, int record, char *name, int p, int capacity, char hits[], int count);
+int checkBaseline(char *fileName, int record);
+double throughput(float (*run)(int pages[], int capacity, int count), int pages[]);
+float benchEngine(int pages[], int capacity, int count);
+float benchReference(int pages[], int capacity, int count);
+float checkLibrary(char *method, int pages[], char hits[], int capacity, int count);
+int checkObjects(void);
+int checkSets(void);
+long long refObjects(int policy, int ids[], int sizes[], double costs[], int count, long long capacity);
+int *generate(int kind, int count, unsigned int seed);
+double now(void);
+
+int benchPolicy;  /*policy being timed*/
+
+char *names[POLICIES] = {"FIFO", "LRU", "Random", "LFU", "LRFU", "AgedLFU"};
+char *methods[POLICIES] = {"fifo", "lru", "extra", NULL, NULL, NULL}; /*policies the library has*/
+policy engines[POLICIES] = {FIFO, LRU, extra, runLFU, runLRFU, runAgedLFU};
+float (*references[POLICIES])(int pages[], char hits[], int capacity, int count) = {refFIFO, refLRU, refRandom, refLFU, refLRFU,
+	refAgedLFU};
+
+/**Main method runs the generated traces and the trace files through every policy and then
+ * checks the throughput against the baseline.
+ * int arg: the number of arguments in the command line.
+ * char *argv[]: optionally --record, the baseline file and the trace files to check. **/
+
+int main(int argc, char *argv[]) {
+
+	int i, failures = 0;
+	int record = argc > 1 && strcmp(argv[1], "--record") == 0;
+	char name[32];
+
+	/*validates number of arguments*/
+	if (argc < 2 + record) {
+		printf("Usage: %s [--record] baseline [trace ...]\n", argv[0]);
+		exit(1);
+	}
+	argv += record; /*the baseline is argv[1] from here*/
+	argc -= record;
+
+	/*generated traces of each kind*/
+	for (i = 0; i < 4; i++) {
+		int *pages = generate(i, 3000, i + 1);
+		if (pages == NULL) {
+			printf("Could not allocate memory\n");
+			exit(1);
+		}
+		sprintf(name, "generated %d", i);
+		failures += checkTrace(name, pages, 3000, NULL, 0);
+		free(pages);
+	}
+
+	/*trace files from the command line*/
+	for (i = 2; i < argc; i++) {
+		int count;
+		int *pages = readTrace(argv[i], &count);
+		if (pages == NULL) {
+			printf("Could not open file %s for reading \n", argv[i]);
+			exit(1);
+		}
+
+		/*golden results of the trace*/
+		char *goldenName = (char*)malloc(strlen(argv[i]) + 8);
+		if (goldenName == NULL) {
+			printf("Could not allocate memory\n");
+			exit(1);
+		}
+		sprintf(goldenName, "%s.golden", argv[i]);
+		FILE *golden = fopen(goldenName, record ? "w" : "r");
+		if (golden == NULL) {
+			printf("%s: no golden results %s\n", argv[i], goldenName);
+			failures++;
+		}
+
+		failures += checkTrace(argv[i], pages, count, golden, record);
+		if (golden != NULL) {
+			fclose(golden);
+		}
+		free(goldenName);
+		free(pages);
+	}
+
+	failures += checkObjects();
+	failures += checkSets();
+	failures += checkBaseline(argv[1], record);
+
+	if (failures) {
+		printf("%d checks failed\n", failures);
+		return 1;
+	}
+	printf("All checks passed\n");
+	return 0;
+}
+
+/**
+ * Runs one trace through every policy with every number of frames and compares the hits and
+ * the miss rate with the reference implementation. Returns the number of mismatches.
+ * char *name: name of the trace for the report.
+ * int pages[]: page references.
+ * int count: number of page references.
+ * FILE *golden: golden results of the trace, NULL if it has none.
+ * int record: 1 to write the golden results instead of comparing with them. **/
+
+int checkTrace(char *name, int pages[], int count, FILE *golden, int record) {
+
+	int p, capacity, i, j, failures = 0;
+	int numDistinct;
+	char *expected = (char*)malloc(count + 1);
+	char *hits = (char*)malloc(count + 1);
+	char *collapsedHits = (char*)malloc(count + 1);
+	char *libraryHits = (char*)malloc(count + 1);
+	int *collapsed = (int*)malloc((count + 1) * sizeof(int));
+	int *runs = (int*)malloc((count + 1) * sizeof(int));
+
+	if (expected == NULL || hits == NULL || collapsedHits == NULL || libraryHits == NULL || collapsed == NULL || runs == NULL) {
+		printf("Could not allocate memory\n");
+		exit(1);
+	}
+
+	/*the trace as page statistics sees it*/
+	memcpy(collapsed, pages, count * sizeof(int));
+	int collapsedCount = collapseTrace(collapsed, runs, count, &numDistinct);
+
+	for (p = 0; p < POLICIES; p++) {
+		for (capacity = 1; capacity <= MAX_FRAMES; capacity++) {
+
+			srandom(SEED);
+			float expectedRate = references[p](pages, expected, capacity, count);
+			srandom(SEED);
+			float rate = engines[p](pages, NULL, hits, capacity, count, 2);
+			srandom(SEED);
+			float collapsedRate = engines[p](collapsed, runs, collapsedHits, capacity, collapsedCount, 2);
+			float libraryRate = expectedRate;
+			if (methods[p] != NULL) {
+				libraryRate = checkLibrary(methods[p], pages, libraryHits, capacity, count);
+			}
+			else {
+				memcpy(libraryHits, expected, count);
+			}
+
+			if (golden != NULL) {
+				failures += checkGolden(golden, record, name, p, capacity, expected, count);
+			}
+
+			/*first reference where the hits differ*/
+			for (i = 0; i < count && hits[i] == expected[i]; i++);
+			if (i < count) {
+				printf("%s, %s, %2d frames: reference %d was a %s, expected a %s\n", name, names[p], capacity,
+					i, hits[i] ? "hit" : "fault", expected[i] ? "hit" : "fault");
+				failures++;
+			}
+
+			for (i = 0; i < count && libraryHits[i] == expected[i]; i++);
+			if (i < count) {
+				printf("%s, %s, %2d frames: library reference %d was a %s, expected a %s\n", name, names[p], capacity,
+					i, libraryHits[i] ? "hit" : "fault", expected[i] ? "hit" : "fault");
+				failures++;
+			}
+
+			/*expand the collapsed hits, repeats are always hits*/
+			for (i = 0, j = 0; i < collapsedCount; j += runs[i], i++) {
+				if (collapsedHits[i] != expected[j] || (runs[i] > 1 && memchr(&expected[j + 1], 0, runs[i] - 1) != NULL)) {
+					printf("%s, %s, %2d frames: collapsed reference %d differs at reference %d\n", name, names[p], capacity, i, j);
+					failures++;
+					break;
+				}
+			}
+
+			/*miss rates must be identical, including no references once memory is full*/
+			if ((rate != expectedRate && !(isnan(rate) && isnan(expectedRate)))
+					|| (collapsedRate != expectedRate && !(isnan(collapsedRate) && isnan(expectedRate)))
+					|| (libraryRate != expectedRate && !(isnan(libraryRate) && isnan(expectedRate)))) {
+				printf("%s, %s, %2d frames: miss rate %0.2f%% collapsed %0.2f%% library %0.2f%%, expected %0.2f%%\n",
+					name, names[p], capacity, rate, collapsedRate, libraryRate, expectedRate);
+				failures++;
+			}
+		}
+	}
+
+	printf("%s: %d references checked, %d failures\n", name, count, failures);
+
+	free(expected);
+	free(hits);
+	free(collapsedHits);
+	free(libraryHits);
+	free(collapsed);
+	free(runs);
+	return failures;
+}
+
+/**
+ * Compares the hits of the reference implementation with one line of the golden results, or
+ * writes the line. A line holds the policy, the number of frames, the misses and references
+ * counted like the policies and a hash of the hits. Returns 1 if they differ.
+ * FILE *golden: golden results of the trace.
+ * int record: 1 to write the line instead of comparing with it.
+ * char *name: name of the trace for the report.
+ * int p: the policy.
+ * int capacity: number of physical memory frames.
+ * char hits[]: hits of the reference implementation.
+ * int count: number of page references. **/
+
+int checkGolden(FILE *golden, int record, char *name, int p, int capacity, char hits[], int count) {
+
+	int i, filled = 0;
+	long long misses = 0, references = 0;
+	unsigned int hash = 2166136261u; /*FNV-1a*/
+
+	for (i = 0; i < count; i++) {
+		if (filled >= capacity) {
+			references++;
+			misses += !hits[i];
+		}
+		filled += !hits[i];
+		hash = (hash ^ (unsigned char)hits[i]) * 16777619u;
+	}
+
+	if (record) {
+		fprintf(golden, "%s %d %lld %lld %08x\n", names[p], capacity, misses, references, hash);
+		return 0;
+	}
+
+	char policyName[32];
+	int goldenCapacity;
+	long long goldenMisses, goldenReferences;
+	unsigned int goldenHash;
+
+	if (fscanf(golden, "%31s %d %lld %lld %x", policyName, &goldenCapacity, &goldenMisses, &goldenReferences, &goldenHash) != 5
+			|| strcmp(policyName, names[p]) != 0 || goldenCapacity != capacity) {
+		printf("%s, %s, %2d frames: golden results are missing or out of order\n", name, names[p], capacity);
+		return 1;
+	}
+	if (goldenMisses != misses || goldenReferences != references || goldenHash != hash) {
+		printf("%s, %s, %2d frames: %lld / %lld misses hash %08x, golden %lld / %lld hash %08x\n", name, names[p],
+			capacity, misses, references, hash, goldenMisses, goldenReferences, goldenHash);
+		return 1;
+	}
+	return 0;
+}
+
+/**
+ * Times every policy and its reference implementation on a generated trace with the frame counts
+ * page statistics uses by default and compares the ratio of their throughputs with the baseline file.
+ * Returns the number of policies that regressed, or 1 if there is no baseline.
+ * char *fileName: name of the baseline file.
+ * int record: 1 to write the baseline instead of comparing with it. **/
+
+int checkBaseline(char *fileName, int record) {
+
+	int p, run, failures = 0;
+	double ratio[POLICIES];
+	int *pages = generate(1, BENCH_PAGES, 42);
+
+	if (pages == NULL) {
+		printf("Could not allocate memory\n");
+		exit(1);
+	}
+
+	/*the policy and its reference take turns so that a slow moment of the machine
+	 *affects both, and the best run of each is kept*/
+	for (p = 0; p < POLICIES; p++) {
+		double engine = 0, reference = 0;
+		benchPolicy = p;
+		for (run = 0; run < BENCH_RUNS; run++) {
+			double e = throughput(benchEngine, pages);
+			double r = throughput(benchReference, pages);
+			engine = e > engine ? e : engine;
+			reference = r > reference ? r : reference;
+		}
+		ratio[p] = engine / reference;
+		printf("%s: %0.0f references/s, %0.2f times its reference implementation\n", names[p], engine, ratio[p]);
+	}
+	free(pages);
+
+	if (record) {
+		FILE *file = fopen(fileName, "w");
+		if (file == NULL) {
+			printf("Error opening write file\n");
+			exit(1);
+		}
+		for (p = 0; p < POLICIES; p++) {
+			fprintf(file, "%s %0.2f\n", names[p], ratio[p]);
+		}
+		fclose(file);
+		printf("Baseline recorded in %s\n", fileName);
+		return 0;
+	}
+
+	FILE *file = fopen(fileName, "r");
+	if (file == NULL) {
+		printf("No baseline %s, record one with --record\n", fileName);
+		return 1;
+	}
+
+	char name[32];
+	double baseline;
+	while (fscanf(file, "%31s %lf", name, &baseline) == 2) {
+		for (p = 0; p < POLICIES; p++) {
+			if (strcmp(name, names[p]) != 0) {
+				continue;
+			}
+			if (ratio[p] < baseline * (1 - REGRESSION)) {
+				printf("%s is more than %0.0f%% slower than its baseline ratio %0.2f\n", names[p], REGRESSION * 100, baseline);
+				failures++;
+			}
+		}
+	}
+	fclose(file);
+	return failures;
+}
+
+/**
+ * Returns the throughput in references per second of one run over the frame counts
+ * page statistics uses by default.
+ * run: runs the trace with a number of frames.
+ * int pages[]: the trace of BENCH_PAGES references. **/
+
+double throughput(float (*run)(int pages[], int capacity, int count), int pages[]) {
+
+	int capacity;
+	long long total = 0;
+	double start = now();
+
+	srandom(SEED);
+	for (capacity = 2; capacity <= MAX_FRAMES; capacity += 7) {
+		run(pages, capacity, BENCH_PAGES);
+		total += BENCH_PAGES;
+	}
+	return total / (now() - start);
+}
+
+/** Runs the policy being timed. **/
+
+float benchEngine(int pages[], int capacity, int count) {
+
+	return engines[benchPolicy](pages, NULL, NULL, capacity, count, 2);
+}
+
+/** Runs the reference implementation of the policy being timed. **/
+
+float benchReference(int pages[], int capacity, int count) {
+
+	static char *hits = NULL;
+	if (hits == NULL) {
+		hits = (char*)malloc(BENCH_PAGES);
+		if (hits == NULL) {
+			printf("Could not allocate memory\n");
+			exit(1);
+		}
+	}
+	return references[benchPolicy](pages, hits, capacity, count);
+}
+
+/**
+ * Runs a trace through the library interface in batches of different sizes.
+ * Returns the miss rate reported by the library.
+ * char *method: policy name as for page simulation.
+ * int pages[]: page references.
+ * char hits[]: set to 1 for each reference that was found in memory.
+ * int capacity: number of physical memory frames.
+ * int count: number of page references. **/
+
+float checkLibrary(char *method, int pages[], char hits[], int capacity, int count) {
+
+	struct pagesim_opts opts;
+	struct pagesim_stats stats;
+	int i, batch;
+
+	opts.seed = SEED;
+	struct pagesim *sim = pagesim_create(method, capacity, &opts);
+	if (sim == NULL) {
+		printf("Could not allocate memory\n");
+		exit(1);
+	}
+
+	for (i = 0, batch = 1; i < count; i += batch, batch = batch * 2 % 997 + 1) {
+		pagesim_access_batch(sim, &pages[i], i + batch <= count ? batch : count - i, &hits[i]);
+	}
+
+	pagesim_stats(sim, &stats);
+	pagesim_destroy(sim);
+	return stats.missRate;
+}
+
+/** LFU without aging, with the signature of the other policies. **/
+
+float runLFU(int pages[], int runs[], char hits[], int pageCapacity, int numPages, int state) {
+
+	return LFU(pages, runs, hits, pageCapacity, numPages, state, 0);
+}
+
+/** LFU that halves the counts every AGE_PERIOD references, with the signature of the other policies. **/
+
+float runAgedLFU(int pages[], int runs[], char hits[], int pageCapacity, int numPages, int state) {
+
+	return LFU(pages, runs, hits, pageCapacity, numPages, state, AGE_PERIOD);
+}
+
+/** LRFU with the default lambda, with the signature of the other policies. **/
+
+float runLRFU(int pages[], int runs[], char hits[], int pageCapacity, int numPages, int state) {
+
+	return LRFU(pages, runs, hits, pageCapacity, numPages, state, LRFU_LAMBDA);
+}
+
+/**
+ * Reference LFU, the page referenced the fewest times is replaced, and among those
+ * the one that reached its count first. Returns the miss rate counted the same way as the policies.
+ * int pages[]: page references.
+ * char hits[]: set to 1 for each reference that was found in memory.
+ * int capacity: number of physical memory frames.
+ * int count: number of page references. **/
+
+float refLFU(int pages[], char hits[], int capacity, int count) {
+
+	int frames[MAX_FRAMES], uses[MAX_FRAMES], reached[MAX_FRAMES];
+	int i, j, size = 0;
+	float misses = 0, references = 0;
+
+	for (i = 0; i < count; i++) {
+		hits[i] = 0;
+		for (j = 0; j < size; j++) {
+			if (frames[j] == pages[i]) {
+				hits[i] = 1;
+				uses[j]++;
+				reached[j] = i;
+			}
+		}
+		if (size == capacity) {
+			references++;
+		}
+		if (hits[i]) {
+			continue;
+		}
+		int victim = size;
+		if (size < capacity) {
+			size++;
+		}
+		else {
+			victim = 0;
+			for (j = 1; j < size; j++) {
+				if (uses[j] < uses[victim] || (uses[j] == uses[victim] && reached[j] < reached[victim])) {
+					victim = j;
+				}
+			}
+			misses++;
+		}
+		frames[victim] = pages[i];
+		uses[victim] = 1;
+		reached[victim] = i;
+	}
+	return (misses/references)*100;
+}
+
+/**
+ * Reference LFU that halves every count, keeping it at 1 or more, after every AGE_PERIOD
+ * references. Pages that end up with the same count keep the order they had before, the page
+ * with the lower count first and then the one that reached its count first.
+ * Returns the miss rate counted the same way as the policies.
+ * int pages[]: page references.
+ * char hits[]: set to 1 for each reference that was found in memory.
+ * int capacity: number of physical memory frames.
+ * int count: number of page references. **/
+
+float refAgedLFU(int pages[], char hits[], int capacity, int count) {
+
+	int frames[MAX_FRAMES], uses[MAX_FRAMES], reached[MAX_FRAMES], rank[MAX_FRAMES];
+	int i, j, k, size = 0;
+	float misses = 0, references = 0;
+
+	for (i = 0; i < count; i++) {
+		hits[i] = 0;
+		for (j = 0; j < size; j++) {
+			if (frames[j] == pages[i]) {
+				hits[i] = 1;
+				uses[j]++;
+				reached[j] = i;
+			}
+		}
+		if (size == capacity) {
+			references++;
+		}
+		if (!hits[i]) {
+			int victim = size;
+			if (size < capacity) {
+				size++;
+			}
+			else {
+				victim = 0;
+				for (j = 1; j < size; j++) {
+					if (uses[j] < uses[victim] || (uses[j] == uses[victim] && reached[j] < reached[victim])) {
+						victim = j;
+					}
+				}
+				misses++;
+			}
+			frames[victim] = pages[i];
+			uses[victim] = 1;
+			reached[victim] = i;
+		}
+
+		if ((i + 1) % AGE_PERIOD != 0) {
+			continue;
+		}
+
+		/*the order before halving decides ties after it*/
+		for (j = 0; j < size; j++) {
+			rank[j] = 0;
+			for (k = 0; k < size; k++) {
+				rank[j] += uses[k] < uses[j] || (uses[k] == uses[j] && reached[k] < reached[j]);
+			}
+		}
+		for (j = 0; j < size; j++) {
+			uses[j] = uses[j] / 2 > 0 ? uses[j] / 2 : 1;
+			reached[j] = i - size + rank[j]; /*before any later reference*/
+		}
+	}
+	return (misses/references)*100;
+}
+
+/**
+ * Reference LRFU with the default lambda, the page with the smallest combined recency and
+ * frequency is replaced, and among those the least recently referenced.
+ * Returns the miss rate counted the same way as the policies.
+ * int pages[]: page references.
+ * char hits[]: set to 1 for each reference that was found in memory.
+ * int capacity: number of physical memory frames.
+ * int count: number of page references. **/
+
+float refLRFU(int pages[], char hits[], int capacity, int count) {
+
+	int frames[MAX_FRAMES], last[MAX_FRAMES];
+	double crf[MAX_FRAMES], key[MAX_FRAMES];
+	double lambda = LRFU_LAMBDA;
+	int i, j, size = 0;
+	float misses = 0, references = 0;
+
+	for (i = 0; i < count; i++) {
+		hits[i] = 0;
+		for (j = 0; j < size; j++) {
+			if (frames[j] == pages[i]) {
+				hits[i] = 1;
+				crf[j] = 1 + crf[j] * pow(2, -lambda * (i - last[j]));
+				last[j] = i;
+				key[j] = log2(crf[j]) + lambda * i;
+			}
+		}
+		if (size == capacity) {
+			references++;
+		}
+		if (hits[i]) {
+			continue;
+		}
+		int victim = size;
+		if (size < capacity) {
+			size++;
+		}
+		else {
+			victim = 0;
+			for (j = 1; j < size; j++) {
+				if (key[j] < key[victim] || (key[j] == key[victim] && last[j] < last[victim])) {
+					victim = j;
+				}
+			}
+			misses++;
+		}
+		frames[victim] = pages[i];
+		crf[victim] = 1;
+		last[victim] = i;
+		key[victim] = lambda * i;
+	}
+	return (misses/references)*100;
+}
+
+/**
+ * Reference FIFO, the page that was placed in memory first is replaced.
+ * Returns the miss rate counted the same way as the policies.
+ * int pages[]: page references.
+ * char hits[]: set to 1 for each reference that was found in memory.
+ * int capacity: number of physical memory frames.
+ * int count: number of page references. **/
+
+float refFIFO(int pages[], char hits[], int capacity, int count) {
+
+	int frames[MAX_FRAMES];
+	int i, j, size = 0, next = 0;
+	float misses = 0, references = 0;
+
+	for (i = 0; i < count; i++) {
+		hits[i] = 0;
+		for (j = 0; j < size; j++) {
+			if (frames[j] == pages[i]) {
+				hits[i] = 1;
+			}
+		}
+		if (size == capacity) {
+			references++;
+		}
+		if (hits[i]) {
+			continue;
+		}
+		if (size < capacity) {
+			frames[size++] = pages[i];
+		}
+		else {
+			frames[next] = pages[i];
+			next = (next + 1) % capacity;
+			misses++;
+		}
+	}
+	return (misses/references)*100;
+}
+
+/**
+ * Reference LRU, the page with the oldest last use is replaced.
+ * Returns the miss rate counted the same way as the policies.
+ * int pages[]: page references.
+ * char hits[]: set to 1 for each reference that was found in memory.
+ * int capacity: number of physical memory frames.
+ * int count: number of page references. **/
+
+float refLRU(int pages[], char hits[], int capacity, int count) {
+
+	int frames[MAX_FRAMES], used[MAX_FRAMES];
+	int i, j, size = 0;
+	float misses = 0, references = 0;
+
+	for (i = 0; i < count; i++) {
+		hits[i] = 0;
+		for (j = 0; j < size; j++) {
+			if (frames[j] == pages[i]) {
+				hits[i] = 1;
+				used[j] = i;
+			}
+		}
+		if (size == capacity) {
+			references++;
+		}
+		if (hits[i]) {
+			continue;
+		}
+		if (size < capacity) {
+			frames[size] = pages[i];
+			used[size++] = i;
+		}
+		else {
+			int oldest = 0;
+			for (j = 1; j < size; j++) {
+				if (used[j] < used[oldest]) {
+					oldest = j;
+				}
+			}
+			frames[oldest] = pages[i];
+			used[oldest] = i;
+			misses++;
+		}
+	}
+	return (misses/references)*100;
+}
+
+/**
+ * Reference random replacement, a frame picked with random() is replaced.
+ * Returns the miss rate counted the same way as the policies.
+ * int pages[]: page references.
+ * char hits[]: set to 1 for each reference that was found in memory.
+ * int capacity: number of physical memory frames.
+ * int count: number of page references. **/
+
+float refRandom(int pages[], char hits[], int capacity, int count) {
+
+	int frames[MAX_FRAMES];
+	int i, j, size = 0;
+	float misses = 0, references = 0;
+
+	for (i = 0; i < count; i++) {
+		hits[i] = 0;
+		for (j = 0; j < size; j++) {
+			if (frames[j] == pages[i]) {
+				hits[i] = 1;
+			}
+		}
+		if (size == capacity) {
+			references++;
+		}
+		if (hits[i]) {
+			continue;
+		}
+		if (size < capacity) {
+			frames[size++] = pages[i];
+		}
+		else {
+			frames[random() % capacity] = pages[i];
+			misses++;
+		}
+	}
+	return (misses/references)*100;
+}
+
+/**
+ * Checks the object cache on objects that change size. A reference whose size differs from
+ * the copy in the cache is a miss, and the bytes of the old copy are given back. Returns the
+ * number of mismatches. FIFO, LRU and GDSF are also compared with a reference object cache on a
+ * generated trace where sizes and miss costs change from one reference to the next. **/
+
+int checkObjects(void) {
+
+	/*a 5000 byte object never fits in 100 bytes, the 10 byte copy must not hit for it*/
+	int grownIds[3] = {0, 0, 0}, grownSizes[3] = {10, 5000, 5000};
+	/*object 0 shrinks from 60 to 30 bytes, which leaves room for object 1 and its 70 bytes*/
+	int shrunkIds[4] = {0, 0, 1, 0}, shrunkSizes[4] = {60, 30, 70, 30};
+	/*a cheap reference lowers the GDSF priority of object 1 below object 0, so 1 is evicted*/
+	int cheaperIds[6] = {0, 1, 2, 1, 3, 1}, cheaperSizes[6] = {1, 1, 1, 1, 1, 1};
+	double cheaperCosts[6] = {1, 10, 10, 0.1, 1, 0.1};
+	double costs[2000];
+	int ids[2000], sizes[2000];
+	int policies[4] = {FIFO_POLICY, LRU_POLICY, RANDOM_POLICY, GDSF_POLICY};
+	char *objectNames[4] = {"FIFO", "LRU", "Random", "GDSF"};
+	struct objectStats stats;
+	int i, p, failures = 0;
+	long long capacity;
+	unsigned int seed = 7;
+
+	for (i = 0; i < 2000; i++) {
+		seed = seed * 1103515245 + 12345;
+		int r = (seed >> 16) & 0x7fff;
+		ids[i] = r % OBJECTS;
+		sizes[i] = 1 + (r / OBJECTS) % 4 * 25 + ids[i]; /*each object takes one of four sizes*/
+		costs[i] = 0.1 + ((seed >> 4) & 0xfff) / 256.0;
+	}
+
+	for (p = 0; p < 4; p++) {
+		simulateObjects(policies[p], grownIds, grownSizes, costs, 3, 1, 100, &stats);
+		if (stats.misses != 3) {
+			printf("%s objects: %lld misses instead of 3 for an object that grows past the cache\n",
+				objectNames[p], stats.misses);
+			failures++;
+		}
+
+		simulateObjects(policies[p], shrunkIds, shrunkSizes, costs, 4, 2, 100, &stats);
+		if (stats.misses != 3) {
+			printf("%s objects: %lld misses instead of 3 for an object that shrinks\n",
+				objectNames[p], stats.misses);
+			failures++;
+		}
+	}
+
+	simulateObjects(GDSF_POLICY, cheaperIds, cheaperSizes, cheaperCosts, 6, 4, 3, &stats);
+	if (stats.misses != 5) {
+		printf("GDSF objects: %lld misses instead of 5 for an object whose priority drops\n", stats.misses);
+		failures++;
+	}
+
+	/*every policy but random, which depends on the random state*/
+	for (p = 0; p < 4; p++) {
+		if (policies[p] == RANDOM_POLICY) {
+			continue;
+		}
+		for (capacity = 100; capacity <= 2000; capacity += 100) {
+			simulateObjects(policies[p], ids, sizes, costs, 2000, OBJECTS, capacity, &stats);
+			long long expected = refObjects(policies[p], ids, sizes, costs, 2000, capacity);
+			if (stats.misses != expected) {
+				printf("%s objects, %lld bytes: %lld misses, reference %lld\n", objectNames[p],
+					capacity, stats.misses, expected);
+				failures++;
+			}
+		}
+	}
+
+	printf("objects: %d failures\n", failures);
+	return failures;
+}
+
+/**
+ * Checks that the random policy of page sets does not depend on the threads the sets run on,
+ * and that one set seeded like random() misses like extra. Returns the number of mismatches. **/
+
+int checkSets(void) {
+
+	int *pages = generate(1, 3000, 5);
+	int ways, threads, failures = 0;
+	long long misses, references, oneMisses, oneReferences;
+
+	if (pages == NULL) {
+		printf("Could not allocate memory\n");
+		exit(1);
+	}
+
+	struct sets *s = newSets(pages, 3000, 16, 4, SET_HASH);
+	if (s == NULL || !simulateSets(s, RANDOM_POLICY, 1, &oneMisses, &oneReferences)) {
+		printf("Could not allocate memory\n");
+		exit(1);
+	}
+	for (threads = 2; threads <= 8; threads *= 2) {
+		simulateSets(s, RANDOM_POLICY, threads, &misses, &references);
+		if (misses != oneMisses || references != oneReferences) {
+			printf("sets, Random, %d threads: %lld / %lld misses, one thread %lld / %lld\n", threads,
+				misses, references, oneMisses, oneReferences);
+			failures++;
+		}
+	}
+	freeSets(s);
+
+	for (ways = 1; ways <= MAX_FRAMES; ways++) {
+		s = newSets(pages, 3000, 1, ways, SET_HASH);
+		if (s == NULL || !simulateSets(s, RANDOM_POLICY, 1, &misses, &references)) {
+			printf("Could not allocate memory\n");
+			exit(1);
+		}
+		freeSets(s);
+
+		/*computed in float like the policies so the rates are identical*/
+		float setMisses = misses, setReferences = references;
+		float rate = (setMisses/setReferences)*100;
+		srandom(SEED);
+		float expected = extra(pages, NULL, NULL, ways, 3000, 2);
+		if (rate != expected && !(isnan(rate) && isnan(expected))) {
+			printf("sets, Random, 1 set of %2d ways: miss rate %0.2f%%, extra %0.2f%%\n", ways, rate, expected);
+			failures++;
+		}
+	}
+
+	free(pages);
+	printf("sets: %d failures\n", failures);
+	return failures;
+}
+
+/**
+ * Reference object cache, the object with the lowest key is evicted until the new object fits.
+ * The key is the time the object was placed for FIFO, the time it was last used for LRU, and
+ * for GDSF the priority L + frequency * cost / size, where L is the key of the last object
+ * evicted. Returns the number of misses.
+ * int policy: FIFO_POLICY, LRU_POLICY or GDSF_POLICY.
+ * int ids[]: object numbers below OBJECTS.
+ * int sizes[]: size of each reference in bytes.
+ * double costs[]: miss cost of each reference.
+ * int count: number of references.
+ * long long capacity: size of the cache in bytes. **/
+
+long long refObjects(int policy, int ids[], int sizes[], double costs[], int count, long long capacity) {
+
+	int size[OBJECTS], freq[OBJECTS]; /*size 0 is not in the cache*/
+	double key[OBJECTS];
+	double inflation = 0;
+	int i, j;
+	long long used = 0, misses = 0;
+
+	for (j = 0; j < OBJECTS; j++) {
+		size[j] = 0;
+	}
+
+	for (i = 0; i < count; i++) {
+		int id = ids[i];
+
+		if (size[id] == sizes[i]) {
+			freq[id]++;
+			if (policy == LRU_POLICY) {
+				key[id] = i;
+			}
+			else if (policy == GDSF_POLICY) {
+				key[id] = inflation + freq[id] * costs[i] / size[id];
+			}
+			continue;
+		}
+
+		/*a stale copy of another size is dropped*/
+		used -= size[id];
+		size[id] = 0;
+		misses++;
+
+		if (sizes[i] > capacity) {
+			continue;
+		}
+		while (used + sizes[i] > capacity) {
+			int lowest = -1;
+			for (j = 0; j < OBJECTS; j++) {
+				if (size[j] > 0 && (lowest < 0 || key[j] < key[lowest])) {
+					lowest = j;
+				}
+			}
+			if (policy == GDSF_POLICY) {
+				inflation = key[lowest];
+			}
+			used -= size[lowest];
+			size[lowest] = 0;
+		}
+		size[id] = sizes[i];
+		freq[id] = 1;
+		key[id] = policy == GDSF_POLICY ? inflation + costs[i] / sizes[i] : i;
+		used += sizes[i];
+	}
+	return misses;
+}
+
+/**
+ * Generates a trace of page references. The generator has its own state so that it does
+ * not change the sequence the random policy sees. Returns NULL if memory cannot be allocated.
+ * int kind: 0 uniform over 150 pages, 1 a working set that moves, 2 a loop over 60 pages,
+ * 3 a small hot set with repeats.
+ * int count: number of page references.
+ * unsigned int seed: seed for the generator. **/
+
+int *generate(int kind, int count, unsigned int seed) {
+
+	int *pages = (int*)malloc(count * sizeof(int));
+	int i, base = 0;
+
+	if (pages == NULL) {
+		return NULL;
+	}
+
+	for (i = 0; i < count; i++) {
+		seed = seed * 1103515245 + 12345;
+		int r = (seed >> 16) & 0x7fff;
+
+		if (kind == 0) {
+			pages[i] = r % 150;
+		}
+		else if (kind == 1) {
+			if (r % 100 == 0) {
+				base = r % 500; /*working set moves*/
+			}
+			pages[i] = base + r % 40;
+		}
+		else if (kind == 2) {
+			pages[i] = i % 60;
+		}
+		else {
+			/*repeat the last page or pick from a hot set*/
+			pages[i] = (i > 0 && r % 3 == 0) ? pages[i - 1] : (r % 5 == 0 ? r % 300 : r % 12);
+		}
+	}
+	return pages;
+}
+
+/** Returns the time in seconds from a monotonic clock. **/
+
+double now(void) {
+
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + t.tv_nsec / 1e9;
+}
@@ -0,0 +1,69 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "header.h"
+
+/**
+ * Page objects sizes a cache of objects of different sizes. It runs an object trace, where each
+ * line is an object number followed by an optional size in bytes and miss cost, through FIFO,
+ * LRU, random and GreedyDual-Size-Frequency caches of the given number of bytes and prints
+ * the miss rate and the byte miss rate of each. Every reference is counted, including those
+ * made before the cache is full. **/
+
+/**Main method reads in the arguments from the command line and validates them.
+ * The method then runs the trace through every policy and prints the miss rates.
+ * int arg: the number of arguments in the command line.
+ * char *argv[]: the capacity in bytes and the object trace. **/
+
+int main(int argc, char *argv[]) {
+
+	long long capacity;
+	int count, p;
+	int *ids, *sizes;
+	double *costs;
+
+	/*validates number of arguments*/
+	if (argc != 3) {
+		printf("Error invalid number of parameters for %s\n", argv[0]);
+		printf("Usage: %s bytes trace\n", argv[0]);
+		exit(1);
+	}
+
+	if (sscanf(argv[1], "%lld", &capacity) != 1 || capacity < 1) {
+		printf("The capacity in bytes must be greater than 0\n");
+		exit(1);
+	}
+
+	if (!readObjects(argv[2], &ids, &sizes, &costs, &count)) {
+		printf("Could not read object trace %s, sizes must be greater than 0\n", argv[2]);
+		exit(1);
+	}
+
+	int numDistinct = renumberTrace(ids, count);
+	if (numDistinct < 0) {
+		printf("Could not allocate memory");
+		exit(1);
+	}
+
+	int policies[4] = {LRU_POLICY, FIFO_POLICY, RANDOM_POLICY, GDSF_POLICY};
+	char *names[4] = {"LRU", "FIFO", "Random", "GDSF"};
+
+	for (p = 0; p < 4; p++) {
+		struct objectStats stats;
+
+		if (!simulateObjects(policies[p], ids, sizes, costs, count, numDistinct, capacity, &stats)) {
+			printf("Could not allocate memory");
+			exit(1);
+		}
+
+		printf("%s, %lld bytes: Miss rate = %lld / %lld = %0.2f%%, Byte miss rate = %lld / %lld = %0.2f%%\n",
+			names[p], capacity, stats.misses, stats.references,
+			stats.references > 0 ? stats.misses * 100.0 / stats.references : 0.0,
+			stats.missedBytes, stats.bytes, stats.bytes > 0 ? stats.missedBytes * 100.0 / stats.bytes : 0.0);
+	}
+
+	free(ids);
+	free(sizes);
+	free(costs);
+	return 0;
+}
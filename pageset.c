@@ -0,0 +1,97 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "header.h"
+
+/**
+ * Page sets simulates a set associative memory, for example to see the effect of page coloring
+ * or of partitioning a cache. Each page maps to one of the sets, by a hash of its page number or
+ * by its color, the page number modulo the number of sets, and each set has the given number of
+ * ways. Page sets prints the miss rate of every replacement policy run within each set, counted
+ * like page statistics once each set is full. The sets are run on as many threads as there are
+ * processors unless a number of threads is given. **/
+
+/**Main method reads in the arguments from the command line and validates them.
+ * The method then splits the trace into sets, runs every policy and prints the miss rates.
+ * int arg: the number of arguments in the command line.
+ * char *argv[]: the sets, ways, mapping, trace and optionally the number of threads. **/
+
+int main(int argc, char *argv[]) {
+
+	int numSets, ways, mapping, count, p;
+	int threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+
+	/*validates number of arguments*/
+	if (argc != 5 && argc != 6) {
+		printf("Error invalid number of parameters for %s\n", argv[0]);
+		printf("Usage: %s sets ways hash|color trace [threads]\n", argv[0]);
+		exit(1);
+	}
+
+	/*reading input from command line */
+	/********************************************************/
+
+	if (sscanf(argv[1], "%d", &numSets) != 1 || numSets < 1) {
+		printf("The number of sets must be greater than 0\n");
+		exit(1);
+	}
+
+	if (sscanf(argv[2], "%d", &ways) != 1 || ways < 1 || ways > 100) {
+		printf("The number of ways must range from 1 to 100\n");
+		exit(1);
+	}
+
+	if (strcmp(argv[3], "hash") == 0) {
+		mapping = SET_HASH;
+	}
+	else if (strcmp(argv[3], "color") == 0) {
+		mapping = SET_COLOR;
+	}
+	else {
+		printf("Incorrect mapping\nPlease pick either hash or color\n");
+		exit(1);
+	}
+
+	if (argc == 6 && (sscanf(argv[5], "%d", &threads) != 1 || threads < 1)) {
+		printf("The number of threads must be greater than 0\n");
+		exit(1);
+	}
+	if (threads < 1) {
+		threads = 1; /*number of processors is not known*/
+	}
+
+	/*the page numbers are kept as they are since the color depends on them*/
+	int *ref = readTrace(argv[4], &count);
+	if (ref == NULL) {
+		printf("Could not open file %s for reading \n", argv[4]);
+		exit(1);
+	}
+
+	/********************************************************/
+
+	struct sets *s = newSets(ref, count, numSets, ways, mapping);
+	if (s == NULL) {
+		printf("Could not allocate memory");
+		exit(1);
+	}
+
+	int policies[5] = {LRU_POLICY, FIFO_POLICY, RANDOM_POLICY, LFU_POLICY, LRFU_POLICY};
+	char *names[5] = {"LRU", "FIFO", "Random", "LFU", "LRFU"};
+
+	for (p = 0; p < 5; p++) {
+		long long misses, references;
+
+		if (!simulateSets(s, policies[p], threads, &misses, &references)) {
+			printf("Could not allocate memory");
+			exit(1);
+		}
+
+		printf("%s, %d sets x %d ways: Miss rate = %lld / %lld = %0.2f%%\n", names[p], numSets, ways,
+			misses, references, references > 0 ? misses * 100.0 / references : 0.0);
+	}
+
+	freeSets(s);
+	free(ref);
+	return 0;
+}
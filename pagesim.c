@@ -16,8 +16,13 @@
 
 int main(int argc, char *argv[]) {
 	
-	int value, numframe;
+	int numframe;
+	int agePeriod = 0;            /*lfu=N halves the counts every N references*/
+	double lambda = LRFU_LAMBDA;  /*lrfu=L sets lambda*/
 	char *method; 
+	
+	/*--profile reports the time spent in each phase on stderr*/ 
+	profileOption(&argc, argv);
 		
 	/*validates number of arguments in the command line*/ 
 	if (argc != 4) {	 /* argument not found in commnad line */ 
@@ -29,8 +34,23 @@ int main(int argc, char *argv[]) {
 	/********************************************************/ 
 	
 	method = argv[3]; /*page replacement method */
-	if (((strcmp(method, "fifo")) != 0) && ((strcmp(method, "lru")) != 0) && ((strcmp(method, "extra")) != 0)) {
-		printf("Incorrect algorithm\nPlease pick either fifo or lru\n");
+	char rest; /*anything after the number makes the method incorrect*/
+	int lfu = strcmp(method, "lfu") == 0 || sscanf(method, "lfu=%d%c", &agePeriod, &rest) == 1;
+	int lrfu = strcmp(method, "lrfu") == 0 || sscanf(method, "lrfu=%lf%c", &lambda, &rest) == 1;
+	if (((strcmp(method, "fifo")) != 0) && ((strcmp(method, "lru")) != 0) && ((strcmp(method, "extra")) != 0)
+			&& !lfu && !lrfu) {
+		printf("Incorrect algorithm\nPlease pick either fifo, lru, extra, lfu[=agePeriod] or lrfu[=lambda]\n");
+		exit(1);
+	}
+
+	if (agePeriod < 0) {
+		printf("The age period of lfu must be greater or equal to 0\n");
+		exit(1);
+	}
+	/*a negative lambda would let a reference lower the key of a page, which breaks the order of LRFU*/
+	if (!(lambda >= 0)) {
+		printf("The lambda of lrfu must be greater or equal to 0\n");
+		exit(1);
 	}
 	
 	/*number of physical frames in memory*/ 
@@ -40,83 +60,46 @@ int main(int argc, char *argv[]) {
 		exit(1);
 	}
 	
-	/*open arg[2] for reading*/ 
-	 
-	 FILE *file = fopen(argv[2], "r"); 
-	 
-	 /*intial size of memory to be read in*/ 
-	 int maxSize = 1000; /*initial size*/ 
-	 
-	 int *ref_temp = (int*)malloc(maxSize*sizeof(int)); /*big enough for 1000 numbers*/ 
-	 
-	 /*memory was not allocated*/ 
-	if (ref_temp == NULL) {
-		 printf("Could not allocate memory"); 
-		 return 0;
-	} 
+	/*reads the page references of arg[2]*/ 
+	profilePhase("read");
 	
-	/* failed to open file */ 
+	int count; 
+	int *ref = readTrace(argv[2], &count); 
 	
-	if (file == 0) {
+	/* failed to open file or allocate memory */ 
+	if (ref == NULL) {
 		printf("Could not open file %s for reading \n", argv[2]);
 		exit(1);
 	}
 	
-	int count = 0, x = 0; 
-	
-	/*counts the number of page references in the file
-	 * and store page reference in local array*/ 
-
-	do {
-		x = fscanf(file, "%d", &value);
-		if (x > 0) {
-			/*if number of page reference exceeds the size of memory
-			 * use realloc to make the memory content larger.*/ 
-			if (maxSize == count-1) {
-				maxSize = maxSize * 2; 
-				ref_temp = (int*)realloc(ref_temp, sizeof(int)*maxSize); 
-			} 
-			/*store page reference in a local array*/ 
-			ref_temp[count] = value;
-			
-			/*increase count*/ 
-			count++;
-		}
-	} while (x > 0);
-	
-	fclose(file); /*close file*/ 
-		
-	int i;
-	int *ref = (int*)malloc(count * sizeof(int)); 
-	
-	if (ref_temp == NULL) {
-		return 0; /*memory wasn't allocated*/ 
-	}  
-	 
-	/*copy into local array to be passed into methods*/ 
-	for (i = 0; i < count; i++) {
-		ref[i] = ref_temp[i]; 
-	}  
-	
-	free(ref_temp); /*free temporary array*/ 
-	
 	/********************************************************/
 	int state = 0; 
 	
-	/*calls the page replacement policy specified by the user*/ 
+	/*calls the page replacement policy specified by the user, printing memory is reported as the print phase*/ 
+	profilePhase("policy");
 	
 	if ((strcmp(method, "fifo"))== 0) {
-		FIFO(&ref[0], numframe, count, state); 
+		FIFO(&ref[0], NULL, NULL, numframe, count, state); 
 	}
 	
 	else if ((strcmp(method, "lru")) == 0) {
-		LRU(&ref[0], numframe, count, state);
+		LRU(&ref[0], NULL, NULL, numframe, count, state);
 	}
 	
 	else if ((strcmp(method, "extra")) == 0) {
-		extra(&ref[0], numframe, count, state); 
+		extra(&ref[0], NULL, NULL, numframe, count, state); 
+	} 
+	
+	else if (lfu) {
+		LFU(&ref[0], NULL, NULL, numframe, count, state, agePeriod); 
+	} 
+	
+	else if (lrfu) {
+		LRFU(&ref[0], NULL, NULL, numframe, count, state, lambda); 
 	} 
 	
+	free(ref); 
+	profileReport();
 	return 0;
 }
 
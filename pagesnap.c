@@ -0,0 +1,125 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "header.h"
+#include "libpagesim.h"
+
+/**
+ * Page snapshot saves the state of a page replacement policy part way through a trace and
+ * continues from it later, so that the tail of a long trace can be studied without simulating
+ * the same prefix again.
+ *
+ *   pagesnap save policy frames trace N snapshot
+ *     runs the first N page references of the trace and saves the state to the snapshot file.
+ *   pagesnap run snapshot trace [trace ...]
+ *     continues from the snapshot with the rest of each trace, every trace starting from its own
+ *     copy of the snapshot, and prints the miss rate of the whole trace.
+ *
+ * The continuation traces must have the same prefix as the saved trace, for example the same
+ * trace or traces that only differ after reference N. **/
+
+void runTail(struct pagesim *sim, char *fileName);
+
+/**Main method reads in the arguments from the command line and validates them.
+ * The method then saves a snapshot or runs the continuations.
+ * int arg: the number of arguments in the command line.
+ * char *argv[]: array of pointer of arguments entered through the commnad line. **/
+
+int main(int argc, char *argv[]) {
+
+	int i;
+
+	if (argc == 7 && strcmp(argv[1], "save") == 0) {
+
+		int numframe, prefix, count;
+		char *method = argv[2];
+
+		sscanf(argv[3], "%d", &numframe);
+		sscanf(argv[5], "%d", &prefix);
+
+		struct pagesim *sim = pagesim_create(method, numframe, NULL);
+		if (sim == NULL) {
+			printf("Incorrect algorithm or number of frames\nPlease pick either fifo, lru or extra and at least 1 frame\n");
+			exit(1);
+		}
+
+		int *ref = readTrace(argv[4], &count);
+		if (ref == NULL) {
+			printf("Could not open file %s for reading \n", argv[4]);
+			exit(1);
+		}
+		if (prefix < 0 || prefix > count) {
+			printf("The number of references must range from 0 to %d\n", count);
+			exit(1);
+		}
+
+		pagesim_access_batch(sim, ref, prefix, NULL);
+
+		if (!pagesim_save(sim, argv[6])) {
+			printf("Error opening write file\n");
+			exit(1);
+		}
+
+		pagesim_destroy(sim);
+		free(ref);
+		return 0;
+	}
+
+	if (argc >= 4 && strcmp(argv[1], "run") == 0) {
+
+		struct pagesim *sim = pagesim_load(argv[2]);
+		if (sim == NULL) {
+			printf("Could not read snapshot %s\n", argv[2]);
+			exit(1);
+		}
+
+		/*each continuation starts from its own copy of the snapshot*/
+		for (i = 3; i < argc; i++) {
+			struct pagesim *fork = pagesim_fork(sim);
+			if (fork == NULL) {
+				printf("Could not allocate memory");
+				exit(1);
+			}
+			runTail(fork, argv[i]);
+			pagesim_destroy(fork);
+		}
+
+		pagesim_destroy(sim);
+		return 0;
+	}
+
+	printf("Error invalid number of parameters for %s\n", argv[0]);
+	printf("Usage: %s save policy frames trace N snapshot\n", argv[0]);
+	printf("       %s run snapshot trace [trace ...]\n", argv[0]);
+	exit(1);
+}
+
+/**
+ * Runs the page references of a trace that come after the snapshot and prints
+ * the miss rate of the whole trace.
+ * struct pagesim *sim: simulator restored from the snapshot.
+ * char *fileName: name of the trace file. **/
+
+void runTail(struct pagesim *sim, char *fileName) {
+
+	struct pagesim_stats stats;
+	int count;
+
+	/*only the references after the snapshot are parsed*/
+	pagesim_stats(sim, &stats);
+	int *ref = readTraceTail(fileName, stats.accesses, &count);
+	if (ref == NULL && count < 0) {
+		printf("%s is shorter than the %lld references in the snapshot\n", fileName, stats.accesses);
+		exit(1);
+	}
+	if (ref == NULL) {
+		printf("Could not open file %s for reading \n", fileName);
+		exit(1);
+	}
+
+	pagesim_access_batch(sim, ref, count, NULL);
+	pagesim_stats(sim, &stats);
+
+	printf("%s: Miss rate = %lld / %lld = %0.2f%%\n", fileName, stats.misses, stats.references, stats.missRate);
+	free(ref);
+}
@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
 #include "header.h" 
 
 /** 
@@ -8,7 +9,22 @@
  * number of physical memory frames as the argument. It then prints out the miss rate
  * for different numbers of physical memory frame. The method reads the content of 
  * the command line and writes the results for each page repalce policy to a file
- * called "pagerates.txt". **/ 
+ * called "pagerates.txt". 
+ * 
+ * With "adaptive" as the last argument the frame counts are not sampled every step frames.
+ * A coarse sweep is refined only between frame counts where the miss rate of a policy changes 
+ * by more than ADAPTIVE_CHANGE or where FIFO misses more with more frames (Belady's anomaly), 
+ * until the frame counts are step apart. Every frame count is one the uniform sweep would run, 
+ * so the adaptive sweep never runs more simulations than it. The chosen frame counts are written 
+ * to pagerates.txt above the miss rates. **/ 
+
+#define ADAPTIVE_CHANGE 1.0  /*change in miss rate, in percent, that is refined*/ 
+#define ADAPTIVE_POINTS 8    /*number of intervals in the coarse sweep*/ 
+#define POLICIES 5           /*LRU, FIFO, random, LFU and LRFU*/ 
+
+void adaptiveSweep(FILE *f, int ref[], int runs[], int count, int min, int max, int step); 
+void measure(int ref[], int runs[], int count, float *rates[], char done[], int frames); 
+void refine(int ref[], int runs[], int count, float *rates[], char done[], int a, int b, int step); 
 
 /**Main method reads in the arguments from the command line and validates them. 
  * The method also calls different page replacement policies with different number of
@@ -19,11 +35,13 @@
 int main(int argc, char *argv[]) {
 	
 	/*variables to store arguement from command line*/ 
-	int value, min, max, step;  
+	int min, max, step;  
 	
+	/*--profile reports the time spent in each phase on stderr*/ 
+	profileOption(&argc, argv);
 	
 	/*validates number of arguments*/ 
-	if (argc != 5) {	  
+	if (argc != 5 && !(argc == 6 && strcmp(argv[5], "adaptive") == 0)) {	  
 		printf("Error invalid number of parameters for %s\n", argv[0]);
 		exit(1); /*exits*/ 
 	}
@@ -47,70 +65,17 @@ int main(int argc, char *argv[]) {
 		exit(1);
 	}
 	
-	/*open arg[4] for reading*/ 
-	 
-	FILE *file = fopen(argv[4], "r"); 
-	 
-	 int maxSize = 1000; /*initial size of memory to be read in*/ 
-	 
-	 
-	 /*temporary pointer to content of page references that are read in from 
-	  * file*/ 
-	  
-	 int *ref_temp = (int*)malloc(maxSize*sizeof(int)); /*big enough for 1000 numbers*/ 
-	 
-	if (ref_temp == NULL) {
-		 printf("Could not allocate memory"); 
-		 return 0;
-	} 
-	
-	/* failed to open file */ 
-	
-	if (file == 0) {
+	/*reads the page references with consecutive repeats collapsed, the
+	 * preprocessed trace is cached so the next run does not redo the work*/ 
+	int count; 
+	int *ref, *runs; 
+	
+	profilePhase("read");
+	if (!loadTrace(argv[4], &ref, &runs, &count)) {
 		printf("Could not open file %s for reading \n", argv[4]);
 		exit(1);
 	}
 	
-	int count = 0, x = 0; 
-	
-	/*counts the number of page references in the file
-	 * and store page reference in local array*/ 
-	do {
-		x = fscanf(file, "%d", &value);
-		if (x > 0) {
-			/*if number of page reference exceeds the size of memory
-			 * use realloc to make the memory content larger.*/ 
-			if (maxSize == count-1) {
-				maxSize = maxSize * 2; 
-				ref_temp = (int*)realloc(ref_temp, sizeof(int)*maxSize); 
-			} 
-			/*store page reference in a local array*/ 
-			ref_temp[count] = value; 
-			
-			/*increase count*/ 
-			count++;
-		}
-	} while (x > 0);
-	
-	fclose(file); /*close file*/ 
-		
-	int i;
-	
-	/*intialize another array*/ 
-	int *ref = (int*)malloc(count * sizeof(int)); 
-	
-	if (ref_temp == NULL) {
-		return 0; /*memory wasn't allocated*/ 
-	}  
-	 
-	/*copy into local array*/ 
-	for (i = 0; i < count; i++) {
-		ref[i] = ref_temp[i]; 
-	}  
-	
-	 /*free temporary array incase it is too large*/
-	free(ref_temp); 
-	
 	/********************************************************/
 	
 	/*open file for reading*/ 
@@ -123,19 +88,33 @@ int main(int argc, char *argv[]) {
 		exit(1);
 	}
 	
+	/*adaptive sweep chooses its own frame counts*/ 
+	if (argc == 6) {
+		if (min < 1 || max < min) {
+			printf("The range number of physical memory frames must start at 1 or more\n");
+			exit(1);
+		}
+		profilePhase("adaptive");
+		adaptiveSweep(f, ref, runs, count, min, max, step);
+		fclose(f);
+		profileReport();
+		return 0;
+	}
+	
 	/*initilize variables to keep track of number of physical frames*/ 
-	int j = min, k = min, l = min;
+	int j = min, k = min, l = min, m = min, n = min;
 	float rate; 
 	
 	fprintf(f, "\n");
 	fprintf(f, "LRU  "); 
 	
-	/*The three different while loops loops throuh all of the replacement policies
+	/*The five different while loops loops throuh all of the replacement policies
 	 * then writes the result to a file*/ 
 	
 	/*calls LRU*/ 
+	profilePhase("LRU");
 	while (j <= max) {
-		rate = LRU(&ref[0], j, count, state);
+		rate = LRU(&ref[0], &runs[0], NULL, j, count, state);
 		fprintf(f, "%6.2f",rate);
 		j+=step;
 	}
@@ -146,8 +125,9 @@ int main(int argc, char *argv[]) {
 	printf("\n");
 	
 	/*calls FIFO*/ 
+	profilePhase("FIFO");
 	while (k <= max) {
-		rate = FIFO(&ref[0], k, count, state);
+		rate = FIFO(&ref[0], &runs[0], NULL, k, count, state);
 		fprintf(f, "%6.2f", rate);
 		k+=step;
 	}
@@ -158,14 +138,180 @@ int main(int argc, char *argv[]) {
 	printf("\n");
 	
 	/*calls random page replacement*/ 
+	profilePhase("Random");
 	while (l <= max) {
-		rate = extra(&ref[0], l, count, state);
+		rate = extra(&ref[0], &runs[0], NULL, l, count, state);
 		fprintf(f, "%6.2f", rate);
 		l+=step;
 	}
 	
+	fprintf(f,"\n"); 
+	fprintf(f, "LFU  "); 
+	
+	printf("\n");
+	
+	/*calls LFU without aging*/ 
+	profilePhase("LFU");
+	while (m <= max) {
+		rate = LFU(&ref[0], &runs[0], NULL, m, count, state, 0);
+		fprintf(f, "%6.2f", rate);
+		m+=step;
+	}
+	
+	fprintf(f,"\n"); 
+	fprintf(f, "LRFU "); 
+	
+	printf("\n");
+	
+	/*calls LRFU*/ 
+	profilePhase("LRFU");
+	while (n <= max) {
+		rate = LRFU(&ref[0], &runs[0], NULL, n, count, state, LRFU_LAMBDA);
+		fprintf(f, "%6.2f", rate);
+		n+=step;
+	}
+	
 	/*done writing to file*/ 
+	profilePhase("write");
 	fclose(f);
 	
+	profileReport();
 	return 0;		
 }
+
+/**
+ * Adaptive sweep measures a coarse set of frame counts and refines between them where the 
+ * miss rate changes sharply, then writes the frame counts and the miss rates to the file. 
+ * FILE *f: pagerates.txt. 
+ * int ref[]: collapsed page references. 
+ * int runs[]: how many times in a row each reference occurred. 
+ * int count: number of collapsed page references. 
+ * int min, max: range of the number of physical memory frames. 
+ * int step: the closest two frame counts can be. **/ 
+
+void adaptiveSweep(FILE *f, int ref[], int runs[], int count, int min, int max, int step) {
+	
+	int i, p, frames; 
+	float *rates[POLICIES]; 
+	char *done = (char*)calloc(max + 1, 1); /*frame counts that have been measured*/ 
+	
+	for (p = 0; p < POLICIES; p++) {
+		rates[p] = (float*)malloc((max + 1) * sizeof(float)); 
+		if (rates[p] == NULL || done == NULL) {
+			printf("Could not allocate memory"); 
+			exit(1);
+		}
+	}
+	
+	/*coarse sweep on the step grid of the uniform sweep, never closer than step*/ 
+	int last = min + (max - min) / step * step; /*largest frame count of the uniform sweep*/ 
+	int coarse = (last - min) / ADAPTIVE_POINTS / step * step; 
+	if (coarse < step) {
+		coarse = step; 
+	}
+	
+	int previous = min; 
+	measure(ref, runs, count, rates, done, min); 
+	for (frames = min + coarse; previous < last; frames += coarse) {
+		if (frames > last) {
+			frames = last; 
+		}
+		measure(ref, runs, count, rates, done, frames); 
+		refine(ref, runs, count, rates, done, previous, frames, step); 
+		previous = frames; 
+	}
+	
+	/*memory never fills with as many frames as there are pages, so there is no miss rate*/ 
+	for (i = min; i <= max; i++) {
+		if (done[i] && isnan(rates[0][i])) {
+			printf("Memory never fills with %d frames or more, their miss rates are not defined\n", i); 
+			break; 
+		}
+	}
+	
+	/*writes the chosen frame counts and the miss rates*/ 
+	char *labels[POLICIES + 1] = {"Frames ", "LRU    ", "FIFO   ", "Random ", "LFU    ", "LRFU   "}; 
+	fprintf(f, "\n"); 
+	for (p = 0; p <= POLICIES; p++) {
+		fprintf(f, "%s", labels[p]); 
+		for (i = min; i <= max; i++) {
+			if (!done[i]) {
+				continue; 
+			}
+			if (p == 0) {
+				fprintf(f, "%6d", i); 
+			}
+			else {
+				fprintf(f, "%6.2f", rates[p - 1][i]); 
+			}
+		}
+		fprintf(f, "\n"); 
+	}
+	
+	for (p = 0; p < POLICIES; p++) {
+		free(rates[p]); 
+	}
+	free(done); 
+}
+
+/**
+ * Runs every policy with one number of frames unless it has already been measured. 
+ * float *rates[]: miss rates of LRU, FIFO, random, LFU and LRFU by number of frames. 
+ * char done[]: set to 1 for each number of frames that has been measured. 
+ * int frames: the number of physical memory frames. **/ 
+
+void measure(int ref[], int runs[], int count, float *rates[], char done[], int frames) {
+	
+	if (done[frames]) {
+		return; 
+	}
+	rates[0][frames] = LRU(&ref[0], &runs[0], NULL, frames, count, 1); 
+	rates[1][frames] = FIFO(&ref[0], &runs[0], NULL, frames, count, 1); 
+	rates[2][frames] = extra(&ref[0], &runs[0], NULL, frames, count, 1); 
+	rates[3][frames] = LFU(&ref[0], &runs[0], NULL, frames, count, 1, 0); 
+	rates[4][frames] = LRFU(&ref[0], &runs[0], NULL, frames, count, 1, LRFU_LAMBDA); 
+	done[frames] = 1; 
+}
+
+/**
+ * Refines between two measured frame counts. The midpoint is measured when the miss rate of 
+ * any policy changes by more than ADAPTIVE_CHANGE, FIFO misses more with more frames or memory 
+ * fills at one end but not the other, and both halves are refined in turn until the frame 
+ * counts are step apart. The midpoint is kept on the step grid. 
+ * int a, b: measured frame counts, a < b, a multiple of step apart. 
+ * int step: the closest two frame counts can be. **/ 
+
+void refine(int ref[], int runs[], int count, float *rates[], char done[], int a, int b, int step) {
+	
+	int p, sharp = 0; 
+	
+	if (b - a < 2 * step) {
+		return; /*target resolution reached, no frame count of the grid in between*/ 
+	}
+	
+	/*the number of frames where memory stops filling*/ 
+	if (!isnan(rates[0][a]) != !isnan(rates[0][b])) {
+		sharp = 1; 
+	}
+	
+	for (p = 0; p < POLICIES; p++) {
+		float change = rates[p][a] - rates[p][b]; 
+		if (change > ADAPTIVE_CHANGE || change < -ADAPTIVE_CHANGE) {
+			sharp = 1; 
+		}
+	}
+	
+	/*Belady's anomaly, FIFO misses more with more frames*/ 
+	if (rates[1][b] > rates[1][a]) {
+		sharp = 1; 
+	}
+	
+	if (!sharp) {
+		return; 
+	}
+	
+	int middle = a + (b - a) / step / 2 * step; 
+	measure(ref, runs, count, rates, done, middle); 
+	refine(ref, runs, count, rates, done, a, middle, step); 
+	refine(ref, runs, count, rates, done, middle, b, step); 
+}
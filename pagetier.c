@@ -0,0 +1,129 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "header.h"
+
+/**
+ * Page tiers simulates a memory hierarchy such as DRAM, far memory and swap. Each tier is given
+ * on the command line as name:frames:latency:policy, fastest tier first, where policy is fifo, lru
+ * or extra. Pages found in a lower tier are promoted into the first tier and pages evicted from a
+ * tier are demoted into the next one, except that pages evicted from the last tier leave memory.
+ * Page tiers prints the hit rate, promotions, demotions and evictions of each tier and the average
+ * access latency, where a reference that is not in any tier costs the fault latency. Unlike page
+ * statistics every reference is counted, including those made before memory is full. **/
+
+#define MAX_TIERS 8
+
+/**Main method reads in the arguments from the command line and validates them.
+ * The method then runs every page reference through the tiers and prints the report.
+ * int arg: the number of arguments in the command line.
+ * char *argv[]: the trace file, the fault latency and the tiers. **/
+
+int main(int argc, char *argv[]) {
+
+	struct tier tiers[MAX_TIERS];
+	char names[MAX_TIERS][32];
+	char method[16];
+	int numTiers = argc - 3;
+	int t, i, frameCount;
+	double faultLatency;
+
+	/*validates number of arguments*/
+	if (argc < 4 || numTiers > MAX_TIERS) {
+		printf("Error invalid number of parameters for %s\n", argv[0]);
+		printf("Usage: %s trace faultLatency name:frames:latency:policy ...\n", argv[0]);
+		exit(1);
+	}
+
+	/*reading input from command line */
+	/********************************************************/
+
+	if (sscanf(argv[2], "%lf", &faultLatency) != 1 || faultLatency < 0) {
+		printf("The fault latency must be a number greater or equal to 0\n");
+		exit(1);
+	}
+
+	for (t = 0; t < numTiers; t++) {
+		if (sscanf(argv[t + 3], "%31[^:]:%d:%lf:%15s", names[t], &frameCount, &tiers[t].latency, method) != 4) {
+			printf("Tier %s must be given as name:frames:latency:policy\n", argv[t + 3]);
+			exit(1);
+		}
+		if (frameCount < 1) {
+			printf("The number of frames of tier %s must be greater than 0\n", names[t]);
+			exit(1);
+		}
+
+		int policy;
+		if (strcmp(method, "fifo") == 0) {
+			policy = FIFO_POLICY;
+		}
+		else if (strcmp(method, "lru") == 0) {
+			policy = LRU_POLICY;
+		}
+		else if (strcmp(method, "extra") == 0) {
+			policy = RANDOM_POLICY;
+		}
+		else {
+			printf("Incorrect algorithm for tier %s\nPlease pick either fifo, lru or extra\n", names[t]);
+			exit(1);
+		}
+
+		tiers[t].name = names[t];
+		tiers[t].frames = newFrames(policy, frameCount);
+		tiers[t].hits = 0;
+		tiers[t].promotions = 0;
+		tiers[t].demotions = 0;
+		tiers[t].evictions = 0;
+		if (tiers[t].frames == NULL) {
+			printf("Could not allocate memory");
+			exit(1);
+		}
+	}
+
+	/*consecutive repeats are collapsed, they are always hits in the first tier*/
+	int count;
+	int *ref, *runs;
+
+	if (!loadTrace(argv[1], &ref, &runs, &count)) {
+		printf("Could not open file %s for reading \n", argv[1]);
+		exit(1);
+	}
+
+	/********************************************************/
+
+	long long total = 0, faults = 0;
+	double latency = 0;
+
+	for (i = 0; i < count; i++) {
+		t = accessTiers(tiers, numTiers, ref[i]);
+		if (t == numTiers) {
+			faults++;
+			latency += faultLatency;
+		}
+		else {
+			latency += tiers[t].latency;
+		}
+
+		/*repeats hit the first tier*/
+		tiers[0].hits += runs[i] - 1;
+		latency += (runs[i] - 1) * tiers[0].latency;
+		total += runs[i];
+	}
+
+	/*prints the report*/
+	printf("%-10s %8s %12s %9s %12s %12s %12s\n", "Tier", "Frames", "Hits", "Hit rate", "Promotions", "Demotions",
+		"Evictions");
+	for (t = 0; t < numTiers; t++) {
+		printf("%-10s %8d %12lld %8.2f%% %12lld %12lld %12lld\n", tiers[t].name, tiers[t].frames->capacity, tiers[t].hits,
+			total > 0 ? tiers[t].hits * 100.0 / total : 0.0, tiers[t].promotions, tiers[t].demotions, tiers[t].evictions);
+	}
+	printf("%-10s %8s %12lld %8.2f%%\n", "Fault", "", faults, total > 0 ? faults * 100.0 / total : 0.0);
+	printf("Average access latency = %0.2f / %lld = %0.2f\n", latency, total, total > 0 ? latency / total : 0.0);
+
+	for (t = 0; t < numTiers; t++) {
+		freeFrames(tiers[t].frames);
+	}
+	free(ref);
+	free(runs);
+	return 0;
+}
@@ -0,0 +1,288 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "header.h"
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+/**
+ * Profiling for page simulation and page statistics, turned on with --profile. The run is split
+ * into phases such as reading the trace and running each policy. Each phase is timed with the
+ * monotonic clock and records how many operations the policies did: page lookups, frames examined
+ * by lookups, frames examined when choosing the page to replace, and evictions. On Linux the
+ * cycles, instructions, cache misses and branch misses of each phase are also read with
+ * perf_event_open. If the counters cannot be opened, for example because perf_event_paranoid does
+ * not allow it, the report leaves them out. The report is written to stderr, as text or as JSON
+ * with --profile=json, so the normal output is not changed.
+ *
+ * Printing the content of memory is timed apart from the policy that prints it: the time and
+ * hardware counts between profilePrintStart and profilePrintEnd are taken out of the phase and
+ * reported as a print phase right after it. **/
+
+#define MAX_PHASES 64
+#define HARDWARE 4
+
+int profiling = 0;
+struct profileCounts profileCounts;
+
+/** Time, operation counts and hardware counters of one phase. **/
+
+struct phase {
+	char name[32];
+	double seconds;
+	struct profileCounts counts;
+	long long hardware[HARDWARE];
+	double printSeconds;              /*part of the phase spent printing*/
+	long long printHardware[HARDWARE];
+};
+
+static struct phase phases[MAX_PHASES];
+static int numPhases = 0;
+static int current = -1;   /*phase being recorded, -1 if none*/
+static int json = 0;
+static double phaseStart;
+static double printStart;
+static long long printHardwareStart[HARDWARE];
+static struct profileCounts countsStart;
+static long long hardwareStart[HARDWARE];
+static int hardwareFd[HARDWARE] = {-1, -1, -1, -1};
+static int hardwareOpen = 0;
+static char *hardwareNames[HARDWARE] = {"cycles", "instructions", "cacheMisses", "branchMisses"};
+
+static double seconds(void);
+static void openHardware(void);
+static void readHardware(long long values[]);
+
+/**
+ * Looks for --profile or --profile=json in the arguments and removes it so the caller sees the
+ * arguments it expects. Turns profiling on and starts the first phase if it is found.
+ * int *argc: number of arguments, reduced by one if the option is found.
+ * char *argv[]: the arguments. **/
+
+void profileOption(int *argc, char *argv[]) {
+
+	int i, j;
+
+	for (i = 1; i < *argc; i++) {
+		if (strcmp(argv[i], "--profile") == 0 || strcmp(argv[i], "--profile=json") == 0) {
+			json = strcmp(argv[i], "--profile=json") == 0;
+			for (j = i; j < *argc - 1; j++) {
+				argv[j] = argv[j + 1];
+			}
+			(*argc)--;
+			argv[*argc] = NULL;
+
+			profiling = 1;
+			openHardware();
+			profilePhase("parse");
+			return;
+		}
+	}
+}
+
+/**
+ * Ends the current phase and starts a new one. Does nothing unless profiling is on.
+ * const char *name: name of the new phase, NULL to only end the current one. **/
+
+void profilePhase(const char *name) {
+
+	int i;
+
+	if (!profiling) {
+		return;
+	}
+
+	double now = seconds();
+	long long hardware[HARDWARE];
+	readHardware(hardware);
+
+	/*record the phase that just ended*/
+	if (current >= 0) {
+		struct phase *p = &phases[current];
+		p->seconds = now - phaseStart;
+		p->counts.lookups = profileCounts.lookups - countsStart.lookups;
+		p->counts.probes = profileCounts.probes - countsStart.probes;
+		p->counts.victimScans = profileCounts.victimScans - countsStart.victimScans;
+		p->counts.evictions = profileCounts.evictions - countsStart.evictions;
+		for (i = 0; i < HARDWARE; i++) {
+			p->hardware[i] = hardware[i] - hardwareStart[i];
+		}
+
+		/*the printing becomes a phase of its own*/
+		if (p->printSeconds > 0 && numPhases < MAX_PHASES) {
+			struct phase *print = &phases[numPhases++];
+			memset(print, 0, sizeof(*print));
+			snprintf(print->name, sizeof(print->name), "print");
+			print->seconds = p->printSeconds;
+			p->seconds -= p->printSeconds;
+			for (i = 0; i < HARDWARE; i++) {
+				print->hardware[i] = p->printHardware[i];
+				p->hardware[i] -= p->printHardware[i];
+			}
+		}
+	}
+
+	if (name == NULL || numPhases == MAX_PHASES) {
+		current = -1; /*stop recording*/
+		return;
+	}
+
+	current = numPhases++;
+	memset(&phases[current], 0, sizeof(phases[current]));
+	snprintf(phases[current].name, sizeof(phases[current].name), "%s", name);
+	countsStart = profileCounts;
+	memcpy(hardwareStart, hardware, sizeof(hardwareStart));
+	/*read the clock last so the bookkeeping is not part of the phase*/
+	phaseStart = seconds();
+}
+
+/** Starts timing the printing of memory. Does nothing unless a phase is being recorded. **/
+
+void profilePrintStart(void) {
+
+	if (!profiling || current < 0) {
+		return;
+	}
+	readHardware(printHardwareStart);
+	printStart = seconds();
+}
+
+/** Adds the time and hardware counts since profilePrintStart to the printing of the current
+ * phase. Does nothing unless a phase is being recorded. **/
+
+void profilePrintEnd(void) {
+
+	int i;
+
+	if (!profiling || current < 0) {
+		return;
+	}
+	double now = seconds();
+	long long hardware[HARDWARE];
+	readHardware(hardware);
+
+	struct phase *p = &phases[current];
+	p->printSeconds += now - printStart;
+	for (i = 0; i < HARDWARE; i++) {
+		p->printHardware[i] += hardware[i] - printHardwareStart[i];
+	}
+}
+
+/** Ends the last phase and writes the report to stderr. Does nothing unless profiling is on. **/
+
+void profileReport(void) {
+
+	int i, h;
+
+	if (!profiling) {
+		return;
+	}
+	profilePhase(NULL);
+
+	if (json) {
+		fprintf(stderr, "{\"hardwareCounters\": %s, \"phases\": [", hardwareOpen ? "true" : "false");
+		for (i = 0; i < numPhases; i++) {
+			struct phase *p = &phases[i];
+			fprintf(stderr, "%s\n  {\"name\": \"%s\", \"seconds\": %.9f, \"lookups\": %lld, \"probes\": %lld, "
+				"\"victimScans\": %lld, \"evictions\": %lld", i ? "," : "", p->name,
+				p->seconds, p->counts.lookups, p->counts.probes, p->counts.victimScans, p->counts.evictions);
+			for (h = 0; h < HARDWARE && hardwareOpen; h++) {
+				fprintf(stderr, ", \"%s\": %lld", hardwareNames[h], p->hardware[h]);
+			}
+			fprintf(stderr, "}");
+		}
+		fprintf(stderr, "\n]}\n");
+		return;
+	}
+
+	fprintf(stderr, "%-12s %12s %12s %10s %12s %10s", "Phase", "Seconds", "Lookups", "Probes/look",
+		"Victim scans", "Evictions");
+	if (hardwareOpen) {
+		fprintf(stderr, " %14s %14s %12s %12s", "Cycles", "Instructions", "Cache miss", "Branch miss");
+	}
+	fprintf(stderr, "\n");
+
+	for (i = 0; i < numPhases; i++) {
+		struct phase *p = &phases[i];
+		fprintf(stderr, "%-12s %12.6f %12lld %10.2f %12lld %10lld", p->name, p->seconds, p->counts.lookups,
+			p->counts.lookups > 0 ? (double)p->counts.probes / p->counts.lookups : 0.0, p->counts.victimScans,
+			p->counts.evictions);
+		if (hardwareOpen) {
+			fprintf(stderr, " %14lld %14lld %12lld %12lld", p->hardware[0], p->hardware[1], p->hardware[2], p->hardware[3]);
+		}
+		fprintf(stderr, "\n");
+	}
+	if (!hardwareOpen) {
+		fprintf(stderr, "Hardware counters are not available\n");
+	}
+}
+
+/** Returns the time in seconds from the monotonic clock. **/
+
+static double seconds(void) {
+
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+/** Opens the hardware counters as one group so they count over the same time.
+ * Leaves hardwareOpen at 0 if any of them cannot be opened. **/
+
+static void openHardware(void) {
+
+#ifdef __linux__
+	unsigned long long configs[HARDWARE] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+		PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+	int i;
+
+	for (i = 0; i < HARDWARE; i++) {
+		struct perf_event_attr attr;
+		memset(&attr, 0, sizeof(attr));
+		attr.type = PERF_TYPE_HARDWARE;
+		attr.size = sizeof(attr);
+		attr.config = configs[i];
+		attr.disabled = i == 0; /*the group starts when its leader is enabled*/
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+
+		hardwareFd[i] = syscall(SYS_perf_event_open, &attr, 0, -1, i == 0 ? -1 : hardwareFd[0], 0);
+		if (hardwareFd[i] < 0) {
+			/*not allowed or not supported, go without*/
+			for (; i >= 0; i--) {
+				if (hardwareFd[i] >= 0) {
+					close(hardwareFd[i]);
+				}
+				hardwareFd[i] = -1;
+			}
+			return;
+		}
+	}
+
+	ioctl(hardwareFd[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+	ioctl(hardwareFd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+	hardwareOpen = 1;
+#endif
+}
+
+/** Reads the hardware counters, all 0 if they are not open. **/
+
+static void readHardware(long long values[]) {
+
+	int i;
+
+	for (i = 0; i < HARDWARE; i++) {
+		values[i] = 0;
+#ifdef __linux__
+		if (hardwareOpen && read(hardwareFd[i], &values[i], sizeof(values[i])) != sizeof(values[i])) {
+			values[i] = 0;
+		}
+#endif
+	}
+}
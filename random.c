@@ -0,0 +1,56 @@
+#include "header.h"
+
+/**
+ * Random numbers for memories that need a sequence of their own, such as the simulators of the
+ * library and the sets of page sets, where sharing random() would make the result depend on the
+ * order the memories run in. The generator is the additive feedback generator random() uses with
+ * its default state of 31 words, so a state seeded with 1 gives the numbers random() gives after
+ * srandom(1) with glibc. It is written out here because random_r(), which keeps that state
+ * outside of random(), is only in glibc. **/
+
+/**
+ * Seeds a state. The table is filled with a linear congruential generator and the first
+ * 310 numbers are thrown away, the same as srandom().
+ * struct randomState *r: the state.
+ * unsigned int seed: the seed, 0 is taken as 1. **/
+
+void seedRandom(struct randomState *r, unsigned int seed) {
+
+	int word;
+	int i;
+
+	if (seed == 0) {
+		seed = 1;
+	}
+	r->table[0] = seed;
+	word = (int)seed; /*a seed of 2^31 or more starts negative, as in srandom()*/
+	for (i = 1; i < RANDOM_DEGREE; i++) {
+		/*16807 * word % 2147483647 without overflowing 31 bits*/
+		long long hi = word / 127773;
+		long long lo = word % 127773;
+		word = (int)(16807 * lo - 2836 * hi);
+		if (word < 0) {
+			word += 2147483647;
+		}
+		r->table[i] = (unsigned int)word;
+	}
+	r->front = RANDOM_SEPARATION;
+	r->rear = 0;
+
+	for (i = 0; i < RANDOM_DEGREE * 10; i++) {
+		nextRandom(r);
+	}
+}
+
+/**
+ * Returns the next number of a state, from 0 to 2^31 - 1.
+ * struct randomState *r: the state. **/
+
+int nextRandom(struct randomState *r) {
+
+	unsigned int value = r->table[r->front] += r->table[r->rear];
+
+	r->front = r->front + 1 < RANDOM_DEGREE ? r->front + 1 : 0;
+	r->rear = r->rear + 1 < RANDOM_DEGREE ? r->rear + 1 : 0;
+	return (int)(value >> 1);
+}
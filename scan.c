@@ -0,0 +1,208 @@
+#include <stdlib.h>
+#include "header.h"
+
+/**
+ * Scans over the frames of physical memory. Page simulation allows at most 100 frames, so
+ * finding a page and finding the page to replace are linear scans of a small array. On x86
+ * the scans compare several frames per instruction: 16 pages per loop with AVX2, 8 with SSE2,
+ * and 4 times per loop when looking for the oldest page with AVX2. The instruction set is
+ * picked once when the program starts, before any thread can scan. Other processors, and
+ * memories with fewer than SCAN_THRESHOLD frames where setting up the vectors costs more than
+ * it saves, use the plain loops. **/
+
+#define SCAN_THRESHOLD 8
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SCAN_X86 1
+#include <immintrin.h>
+#endif
+
+static int findScalar(const int frames[], int capacity, int page);
+static int oldestScalar(const long long time[], int capacity);
+
+static int (*findScan)(const int frames[], int capacity, int page) = findScalar;
+static int (*oldestScan)(const long long time[], int capacity) = oldestScalar;
+
+/**
+ * Finds a page in memory. Returns the index of the first frame holding the page
+ * or -1 if the page is not in memory.
+ * const int frames[]: page in each frame.
+ * int capacity: number of physical memory frames.
+ * int page: page being searched for. **/
+
+int findFrame(const int frames[], int capacity, int page) {
+
+	int i;
+
+	if (capacity < SCAN_THRESHOLD) {
+		i = findScalar(frames, capacity, page);
+	}
+	else {
+		i = findScan(frames, capacity, page);
+	}
+
+	PROFILE_COUNT(lookups, 1);
+	PROFILE_COUNT(probes, i >= 0 ? i + 1 : capacity);
+	return i;
+}
+
+/**
+ * Finds the frame with the smallest time, the page to replace for FIFO and LRU.
+ * Returns the first such frame.
+ * const long long time[]: time of each frame.
+ * int capacity: number of physical memory frames, at least 1. **/
+
+int oldestFrame(const long long time[], int capacity) {
+
+	PROFILE_COUNT(victimScans, capacity);
+
+	if (capacity < SCAN_THRESHOLD) {
+		return oldestScalar(time, capacity);
+	}
+	return oldestScan(time, capacity);
+}
+
+/** Plain loop for findFrame. **/
+
+static int findScalar(const int frames[], int capacity, int page) {
+
+	int i;
+	for (i = 0; i < capacity; i++) {
+		if (frames[i] == page) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+/** Plain loop for oldestFrame. **/
+
+static int oldestScalar(const long long time[], int capacity) {
+
+	int i, oldest = 0;
+	for (i = 1; i < capacity; i++) {
+		if (time[i] < time[oldest]) {
+			oldest = i;
+		}
+	}
+	return oldest;
+}
+
+#ifdef SCAN_X86
+
+/** findFrame with SSE2, compares 8 frames per loop. **/
+
+__attribute__((target("sse2")))
+static int findSSE2(const int frames[], int capacity, int page) {
+
+	__m128i key = _mm_set1_epi32(page);
+	int i;
+
+	for (i = 0; i + 8 <= capacity; i += 8) {
+		__m128i a = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)&frames[i]), key);
+		__m128i b = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)&frames[i + 4]), key);
+		int mask = _mm_movemask_ps(_mm_castsi128_ps(a)) | (_mm_movemask_ps(_mm_castsi128_ps(b)) << 4);
+		if (mask) {
+			return i + __builtin_ctz(mask);
+		}
+	}
+
+	/*frames left over*/
+	for (; i < capacity; i++) {
+		if (frames[i] == page) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+/** findFrame with AVX2, compares 16 frames per loop. **/
+
+__attribute__((target("avx2")))
+static int findAVX2(const int frames[], int capacity, int page) {
+
+	__m256i key = _mm256_set1_epi32(page);
+	int i;
+
+	for (i = 0; i + 16 <= capacity; i += 16) {
+		__m256i a = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)&frames[i]), key);
+		__m256i b = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)&frames[i + 8]), key);
+		int mask = _mm256_movemask_ps(_mm256_castsi256_ps(a)) | (_mm256_movemask_ps(_mm256_castsi256_ps(b)) << 8);
+		if (mask) {
+			return i + __builtin_ctz(mask);
+		}
+	}
+
+	/*fewer than 16 frames left*/
+	if (i + 8 <= capacity) {
+		__m256i a = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)&frames[i]), key);
+		int mask = _mm256_movemask_ps(_mm256_castsi256_ps(a));
+		if (mask) {
+			return i + __builtin_ctz(mask);
+		}
+		i += 8;
+	}
+	for (; i < capacity; i++) {
+		if (frames[i] == page) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+/** oldestFrame with AVX2, keeps the smallest time and its index in each of 4 lanes. **/
+
+__attribute__((target("avx2")))
+static int oldestAVX2(const long long time[], int capacity) {
+
+	__m256i best = _mm256_loadu_si256((const __m256i *)&time[0]);
+	__m256i bestIndex = _mm256_set_epi64x(3, 2, 1, 0);
+	__m256i index = bestIndex;
+	__m256i four = _mm256_set1_epi64x(4);
+	int i, lane;
+
+	for (i = 4; i + 4 <= capacity; i += 4) {
+		index = _mm256_add_epi64(index, four);
+		__m256i t = _mm256_loadu_si256((const __m256i *)&time[i]);
+		__m256i older = _mm256_cmpgt_epi64(best, t); /*strictly older keeps the first frame on ties*/
+		best = _mm256_blendv_epi8(best, t, older);
+		bestIndex = _mm256_blendv_epi8(bestIndex, index, older);
+	}
+
+	/*combine the lanes*/
+	long long times[4], indexes[4];
+	_mm256_storeu_si256((__m256i *)times, best);
+	_mm256_storeu_si256((__m256i *)indexes, bestIndex);
+
+	int oldest = (int)indexes[0];
+	for (lane = 1; lane < 4; lane++) {
+		if (times[lane] < time[oldest] || (times[lane] == time[oldest] && indexes[lane] < oldest)) {
+			oldest = (int)indexes[lane];
+		}
+	}
+
+	/*frames left over*/
+	for (; i < capacity; i++) {
+		if (time[i] < time[oldest]) {
+			oldest = i;
+		}
+	}
+	return oldest;
+}
+
+/** Picks the scans for the instruction sets the processor supports. Runs before main, so the
+ * scans are never changed while threads use them. **/
+
+__attribute__((constructor)) static void chooseScans(void) {
+
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("sse2")) {
+		findScan = findSSE2;
+	}
+	if (__builtin_cpu_supports("avx2")) {
+		findScan = findAVX2;
+		oldestScan = oldestAVX2;
+	}
+}
+
+#endif
@@ -0,0 +1,318 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "header.h"
+
+/**
+ * Implements a set associative memory. The frames are split into sets of the same number of
+ * ways and every page can only be placed in the frames of one set, chosen from its page number
+ * either by a hash or by its color, the low bits that page coloring uses. A page fault replaces
+ * a page of the same set, so each set behaves like a small memory of its own running the
+ * replacement policy, and a set counts references once its own frames are full.
+ *
+ * Sets never affect each other, so the trace is split into one trace per set and the sets are
+ * run on separate threads, each adding up the counts of its own sets before they are merged.
+ * Splitting the trace brings references to the same page together, so consecutive duplicates
+ * within a set are collapsed again. LRFU's time and LFU's aging count the references of the set.
+ *
+ * The random policy cannot take its numbers from random(), which every thread shares, so each
+ * set has its own random state, see random.c, seeded with the number of the set plus 1. A set
+ * then replaces the same frames whichever thread runs it and the result is the same every run. **/
+
+/** Work of one thread: the sets it runs and the counts it adds up. **/
+
+struct setWork {
+	struct sets *s;
+	int policy;
+	int first;         /*first set, then every step sets*/
+	int step;
+	char *hits;        /*hit of each reference, indexed like the pages of the sets*/
+	long long misses;
+	long long references;
+};
+
+static unsigned int setOf(int page, int numSets, int mapping);
+static void *runSets(void *arg);
+static void runSet(struct sets *s, int set, int policy, char hits[], long long *misses, long long *references);
+static void runRandom(int pages[], char hits[], int ways, int n, unsigned int seed);
+
+/**
+ * Splits a trace into the traces of the sets. Returns NULL if memory cannot be allocated.
+ * int pages[]: page references, not changed.
+ * int count: number of page references.
+ * int numSets: number of sets.
+ * int ways: number of frames in each set.
+ * int mapping: SET_HASH or SET_COLOR. **/
+
+struct sets *newSets(int pages[], int count, int numSets, int ways, int mapping) {
+
+	int i, set;
+
+	struct sets *s = (struct sets *)malloc(sizeof(struct sets));
+	if (s == NULL) {
+		return NULL;
+	}
+
+	s->numSets = numSets;
+	s->ways = ways;
+	s->pages = (int*)malloc((count > 0 ? count : 1) * sizeof(int));
+	s->runs = (int*)malloc((count > 0 ? count : 1) * sizeof(int));
+	s->start = (int*)calloc(numSets, sizeof(int));
+	s->length = (int*)calloc(numSets, sizeof(int));
+	unsigned int *setOfRef = (unsigned int*)malloc((count > 0 ? count : 1) * sizeof(unsigned int));
+
+	if (s->pages == NULL || s->runs == NULL || s->start == NULL || s->length == NULL || setOfRef == NULL) {
+		free(setOfRef);
+		freeSets(s);
+		return NULL;
+	}
+
+	/*count the references of each set and place the sets one after the other*/
+	for (i = 0; i < count; i++) {
+		setOfRef[i] = setOf(pages[i], numSets, mapping);
+		s->length[setOfRef[i]]++;
+	}
+	for (set = 1; set < numSets; set++) {
+		s->start[set] = s->start[set - 1] + s->length[set - 1];
+	}
+
+	/*copy each reference to the end of its set, collapsing it into the reference before*/
+	memset(s->length, 0, numSets * sizeof(int));
+	for (i = 0; i < count; i++) {
+		set = setOfRef[i];
+		int end = s->start[set] + s->length[set];
+
+		if (s->length[set] > 0 && s->pages[end - 1] == pages[i]) {
+			s->runs[end - 1]++;
+		}
+		else {
+			s->pages[end] = pages[i];
+			s->runs[end] = 1;
+			s->length[set]++;
+		}
+	}
+
+	free(setOfRef);
+	return s;
+}
+
+/** Frees the traces of the sets.
+ * struct sets *s: sets to free. **/
+
+void freeSets(struct sets *s) {
+
+	if (s == NULL) {
+		return;
+	}
+	free(s->pages);
+	free(s->runs);
+	free(s->start);
+	free(s->length);
+	free(s);
+}
+
+/**
+ * Runs every set through a replacement policy and adds up the misses and references of all
+ * sets, counted like page statistics once each set is full. Returns 0 if memory cannot be
+ * allocated.
+ * struct sets *s: the sets.
+ * int policy: FIFO_POLICY, LRU_POLICY, RANDOM_POLICY, LFU_POLICY or LRFU_POLICY.
+ * int threads: number of threads to run the sets on, at least 1.
+ * long long *misses: set to the misses of all sets.
+ * long long *references: set to the references of all sets. **/
+
+int simulateSets(struct sets *s, int policy, int threads, long long *misses, long long *references) {
+
+	int t, count = s->start[s->numSets - 1] + s->length[s->numSets - 1];
+
+	if (threads > s->numSets) {
+		threads = s->numSets;
+	}
+	if (threads < 1) {
+		threads = 1; /*the calling thread always runs the first share*/
+	}
+
+	char *hits = (char*)malloc(count > 0 ? count : 1);
+	struct setWork *work = (struct setWork *)malloc(threads * sizeof(struct setWork));
+	pthread_t *ids = (pthread_t *)malloc(threads * sizeof(pthread_t));
+	char *started = (char*)calloc(threads, 1);
+
+	if (hits == NULL || work == NULL || ids == NULL || started == NULL) {
+		free(hits);
+		free(work);
+		free(ids);
+		free(started);
+		return 0;
+	}
+
+	/*sets are dealt out in turn so that each thread gets a share of the busy ones*/
+	for (t = 0; t < threads; t++) {
+		work[t].s = s;
+		work[t].policy = policy;
+		work[t].first = t;
+		work[t].step = threads;
+		work[t].hits = hits;
+		work[t].misses = 0;
+		work[t].references = 0;
+	}
+	for (t = 1; t < threads; t++) {
+		started[t] = pthread_create(&ids[t], NULL, runSets, &work[t]) == 0;
+	}
+
+	/*this thread runs the first share and any share a thread could not be started for*/
+	runSets(&work[0]);
+	for (t = 1; t < threads; t++) {
+		if (started[t]) {
+			pthread_join(ids[t], NULL);
+		}
+		else {
+			runSets(&work[t]);
+		}
+	}
+
+	/*merge the counts of the threads*/
+	*misses = 0;
+	*references = 0;
+	for (t = 0; t < threads; t++) {
+		*misses += work[t].misses;
+		*references += work[t].references;
+	}
+
+	free(hits);
+	free(work);
+	free(ids);
+	free(started);
+	return 1;
+}
+
+/** Returns the set of a page.
+ * int page: the page number.
+ * int numSets: number of sets.
+ * int mapping: SET_HASH or SET_COLOR. **/
+
+static unsigned int setOf(int page, int numSets, int mapping) {
+
+	unsigned int h = (unsigned int)page;
+
+	if (mapping == SET_HASH) {
+		/*mixes every bit of the page number into the low bits*/
+		h ^= h >> 16;
+		h *= 0x85ebca6bu;
+		h ^= h >> 13;
+		h *= 0xc2b2ae35u;
+		h ^= h >> 16;
+	}
+	return h % (unsigned int)numSets;
+}
+
+/** Thread that runs its share of the sets.
+ * void *arg: the struct setWork of the thread. **/
+
+static void *runSets(void *arg) {
+
+	struct setWork *w = (struct setWork *)arg;
+	int set;
+
+	for (set = w->first; set < w->s->numSets; set += w->step) {
+		runSet(w->s, set, w->policy, w->hits, &w->misses, &w->references);
+	}
+	return NULL;
+}
+
+/**
+ * Runs one set through a replacement policy and adds its misses and references. The policies
+ * only return a miss rate, so the counts are taken from the hits: every policy fills one frame
+ * per miss, so the set is full once it has missed as many times as it has ways.
+ * struct sets *s: the sets.
+ * int set: the set to run.
+ * int policy: the replacement policy.
+ * char hits[]: hit of each reference of the sets, the part of this set is written.
+ * long long *misses, *references: counts of the thread. **/
+
+static void runSet(struct sets *s, int set, int policy, char hits[], long long *misses, long long *references) {
+
+	int n = s->length[set];
+	int *pages = &s->pages[s->start[set]];
+	int *runs = &s->runs[s->start[set]];
+	char *hit = &hits[s->start[set]];
+	int i, filled = 0;
+
+	if (n == 0) {
+		return;
+	}
+
+	/*state 2 prints nothing*/
+	if (policy == FIFO_POLICY) {
+		FIFO(pages, runs, hit, s->ways, n, 2);
+	}
+	else if (policy == LRU_POLICY) {
+		LRU(pages, runs, hit, s->ways, n, 2);
+	}
+	else if (policy == RANDOM_POLICY) {
+		runRandom(pages, hit, s->ways, n, set + 1);
+	}
+	else if (policy == LFU_POLICY) {
+		LFU(pages, runs, hit, s->ways, n, 2, 0);
+	}
+	else {
+		LRFU(pages, runs, hit, s->ways, n, 2, LRFU_LAMBDA);
+	}
+
+	for (i = 0; i < n; i++) {
+		if (filled >= s->ways) {
+			(*references)++;
+			if (!hit[i]) {
+				(*misses)++;
+			}
+		}
+		if (!hit[i]) {
+			filled++;
+		}
+
+		/*collapsed repeats are hits*/
+		if (filled >= s->ways) {
+			*references += runs[i] - 1;
+		}
+	}
+}
+
+/**
+ * Runs one set through the random policy with a random state of its own. The frames are
+ * filled in order and a fault in full memory replaces a random frame, the same as extra.
+ * Collapsed repeats are hits that change nothing.
+ * int pages[]: references of the set.
+ * char hits[]: set to 1 for each reference that was found in memory.
+ * int ways: number of frames in the set.
+ * int n: number of references.
+ * unsigned int seed: seed of the random state. **/
+
+static void runRandom(int pages[], char hits[], int ways, int n, unsigned int seed) {
+
+	int framePages[ways];
+	long long frameTime[ways];
+	struct randomState random;
+	struct frames f;
+	int i;
+
+	f.policy = RANDOM_POLICY;
+	f.capacity = ways;
+	f.size = 0;
+	f.clock = 0;
+	f.pages = framePages;
+	f.time = frameTime;
+	f.random = &random;
+	for (i = 0; i < ways; i++) {
+		framePages[i] = -1; /*empty frame*/
+		frameTime[i] = 0;
+	}
+
+	seedRandom(&random, seed);
+
+	for (i = 0; i < n; i++) {
+		hits[i] = findPage(&f, pages[i]) >= 0;
+		if (!hits[i]) {
+			placePage(&f, pages[i]);
+		}
+	}
+}
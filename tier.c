@@ -0,0 +1,169 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "header.h"
+
+/**
+ * Implements a memory hierarchy made of an ordered list of tiers, for example DRAM, far memory
+ * and swap. Each tier has its own number of frames, access latency and replacement policy.
+ * A page is in at most one tier at a time. A referenced page is always brought into the first
+ * tier: a page found in a lower tier is promoted, and a page that is not in any tier is a fault.
+ * The page a tier evicts to make room is demoted into the next tier, and the page evicted from
+ * the last tier leaves memory.
+ *
+ * The frames of a tier are kept in an array. Unlike the FIFO, LRU and extra methods a page
+ * can leave a tier in the middle of the array when it is promoted, so FIFO keeps the time each
+ * page was placed in memory and replaces the oldest instead of using a circular queue. **/
+
+/**
+ * Allocates the frames of one tier, all empty. Returns NULL if memory cannot be allocated.
+ * int policy: FIFO_POLICY, LRU_POLICY or RANDOM_POLICY.
+ * int capacity: number of physical memory frames. **/
+
+struct frames *newFrames(int policy, int capacity) {
+
+	struct frames *f = (struct frames *)malloc(sizeof(struct frames));
+	if (f == NULL) {
+		return NULL;
+	}
+
+	f->policy = policy;
+	f->capacity = capacity;
+	f->size = 0;
+	f->clock = 0;
+	f->random = NULL;
+	f->pages = (int*)malloc(capacity * sizeof(int));
+	f->time = (long long*)malloc(capacity * sizeof(long long));
+
+	if (f->pages == NULL || f->time == NULL) {
+		freeFrames(f);
+		return NULL;
+	}
+
+	int i;
+	for (i = 0; i < capacity; i++) {
+		f->pages[i] = -1; /*empty frame*/
+		f->time[i] = 0;
+	}
+	return f;
+}
+
+/** Frees the frames of a tier.
+ * struct frames *f: frames to free. **/
+
+void freeFrames(struct frames *f) {
+
+	if (f == NULL) {
+		return;
+	}
+	free(f->pages);
+	free(f->time);
+	free(f);
+}
+
+/**
+ * Searches the frames for a page. Returns the index of the frame holding the page
+ * or -1 if the page is not in memory. LRU counts the reference as a use of the page.
+ * struct frames *f: frames to search.
+ * int page: current page being referenced. **/
+
+int findPage(struct frames *f, int page) {
+
+	f->clock++;
+	int i = findFrame(f->pages, f->capacity, page);
+	if (i >= 0 && f->policy == LRU_POLICY) {
+		f->time[i] = f->clock; /*page is used again*/
+	}
+	return i;
+}
+
+/**
+ * Places a page in the frames. If the frames are full the page chosen by the policy is
+ * replaced and returned, otherwise -1 is returned.
+ * struct frames *f: frames to place the page in.
+ * int page: page being placed in memory. **/
+
+int placePage(struct frames *f, int page) {
+
+	int victim;
+
+	f->clock++;
+
+	if (f->size < f->capacity) {
+		victim = findFrame(f->pages, f->capacity, -1); /*first empty frame*/
+		f->size++;
+	}
+	else if (f->policy == RANDOM_POLICY && f->random != NULL) {
+		victim = nextRandom(f->random) % f->capacity;
+	}
+	else if (f->policy == RANDOM_POLICY) {
+		victim = random() % f->capacity;
+	}
+	else {
+		/*FIFO and LRU both replace the page with the oldest time*/
+		victim = oldestFrame(f->time, f->capacity);
+	}
+
+	int evicted = f->pages[victim];
+	if (evicted != -1) {
+		PROFILE_COUNT(evictions, 1);
+	}
+	f->pages[victim] = page;
+	f->time[victim] = f->clock;
+	return evicted;
+}
+
+/**
+ * Removes the page in a frame, leaving the frame empty.
+ * struct frames *f: frames to remove the page from.
+ * int index: index of the frame. **/
+
+void removePage(struct frames *f, int index) {
+
+	f->pages[index] = -1;
+	f->size--;
+}
+
+/**
+ * References a page in the hierarchy. The page is looked up in each tier in order. If it is
+ * found in a lower tier it is promoted into the first tier, and pages evicted along the way are
+ * demoted one tier down. A page evicted from the last tier leaves memory and counts as an
+ * eviction. Returns the index of the tier the page was found in, or the number of tiers if the
+ * page was not in memory.
+ * struct tier tiers[]: the tiers, fastest first.
+ * int numTiers: number of tiers.
+ * int page: current page being referenced. **/
+
+int accessTiers(struct tier tiers[], int numTiers, int page) {
+
+	int t, index = -1;
+
+	for (t = 0; t < numTiers; t++) {
+		index = findPage(tiers[t].frames, page);
+		if (index >= 0) {
+			break;
+		}
+	}
+
+	if (t < numTiers) {
+		tiers[t].hits++;
+		if (t == 0) {
+			return 0; /*already in the first tier*/
+		}
+		removePage(tiers[t].frames, index);
+		tiers[t].promotions++;
+	}
+
+	/*place in the first tier and demote what it evicts down the tiers*/
+	int level, moving = page;
+	for (level = 0; level < numTiers && moving != -1; level++) {
+		moving = placePage(tiers[level].frames, moving);
+		if (moving != -1 && level == numTiers - 1) {
+			tiers[level].evictions++; /*nowhere left to demote to*/
+		}
+		else if (moving != -1) {
+			tiers[level].demotions++;
+		}
+	}
+	return t;
+}
@@ -0,0 +1,379 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "header.h"
+
+/**
+ * Trace preprocessing reads the page references from a file and prepares them for
+ * page statistics. A reference to the page that was just referenced is always a hit
+ * under every replacement policy, so consecutive duplicates are collapsed into a single
+ * reference with a run length. The run lengths are passed to the policies which count
+ * the skipped references as hits, so the miss rates do not change. Page numbers are also
+ * renumbered densely from 0 in order of first appearance. The preprocessed trace is cached
+ * in a file next to the trace so that repeated page statistics runs can reuse it. **/
+
+#define CACHE_MAGIC 0x324c5250 /*"PRL2"*/
+
+/** Header of the cached preprocessed trace. The size, inode and modification time of the
+ * original trace, to the nanosecond, are stored so that a stale cache is never used, even
+ * when the trace is written again within the same second. **/
+
+struct traceCache {
+	int magic;
+	int count;         /*number of references after collapsing*/
+	int numDistinct;   /*number of distinct pages*/
+	int total;         /*number of references before collapsing*/
+	long long srcSize;
+	long long srcTime;
+	long long srcNsec;  /*nanoseconds of the modification time*/
+	long long srcInode;
+};
+
+static int *readReferences(FILE *file, int *count);
+static int skipReferences(FILE *file, long long skip);
+static int compareInt(const void *a, const void *b);
+static int readCache(char *cacheName, struct stat *src, int **pages, int **runs, int *count);
+static void writeCache(char *cacheName, struct stat *src, int pages[], int runs[], int count, int numDistinct, int total);
+
+/**
+ * Reads all the page references in a file into an array that grows as needed.
+ * Returns NULL if the file cannot be opened or memory cannot be allocated.
+ * char *fileName: name of the file containing the page references.
+ * int *count: set to the number of page references read. **/
+
+int *readTrace(char *fileName, int *count) {
+
+	FILE *file = fopen(fileName, "r");
+	if (file == NULL) {
+		return NULL;
+	}
+
+	int *ref = readReferences(file, count);
+	fclose(file);
+	return ref;
+}
+
+/**
+ * Reads the page references of a file that come after the first skip references. The skipped
+ * references are passed over without being converted, so continuing a long trace from a snapshot
+ * does not pay for parsing its prefix. Returns NULL if the file cannot be opened, memory cannot be
+ * allocated or the file has fewer than skip references, in which case count is set to -1.
+ * char *fileName: name of the file containing the page references.
+ * long long skip: number of references to pass over.
+ * int *count: set to the number of page references read after them. **/
+
+int *readTraceTail(char *fileName, long long skip, int *count) {
+
+	*count = 0;
+	FILE *file = fopen(fileName, "r");
+	if (file == NULL) {
+		return NULL;
+	}
+
+	if (!skipReferences(file, skip)) {
+		fclose(file);
+		*count = -1;
+		return NULL;
+	}
+
+	int *ref = readReferences(file, count);
+	fclose(file);
+	return ref;
+}
+
+/**
+ * Reads the page references from the current position of a file into an array that grows
+ * as needed. Returns NULL if memory cannot be allocated.
+ * FILE *file: file to read, left open.
+ * int *count: set to the number of page references read. **/
+
+static int *readReferences(FILE *file, int *count) {
+
+	int maxSize = 1000; /*initial size*/
+	int *ref = (int*)malloc(maxSize * sizeof(int));
+	int value, n = 0;
+
+	if (ref == NULL) {
+		return NULL;
+	}
+
+	while (fscanf(file, "%d", &value) > 0) {
+		/*array is full, double its size*/
+		if (n == maxSize) {
+			maxSize = maxSize * 2;
+			int *temp = (int*)realloc(ref, sizeof(int) * maxSize);
+			if (temp == NULL) {
+				free(ref);
+				return NULL;
+			}
+			ref = temp;
+		}
+		ref[n] = value;
+		n++;
+	}
+
+	*count = n;
+	return ref;
+}
+
+/**
+ * Moves a file past its first references by counting the words separated by white space, and
+ * leaves it at the start of the next one. Returns 0 if the file has fewer references.
+ * FILE *file: file to move, at its start.
+ * long long skip: number of references to pass over. **/
+
+static int skipReferences(FILE *file, long long skip) {
+
+	char buffer[65536];
+	long long seen = 0, position = 0;
+	int inWord = 0;
+	size_t i, n;
+
+	if (skip == 0) {
+		return 1;
+	}
+
+	while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+		for (i = 0; i < n; i++) {
+			int space = isspace((unsigned char)buffer[i]);
+			if (!space && !inWord) {
+				if (seen == skip) {
+					/*start of the first reference to read*/
+					return fseek(file, position + i, SEEK_SET) == 0;
+				}
+				seen++;
+			}
+			inWord = !space;
+		}
+		position += n;
+	}
+	return seen == skip; /*nothing after the skipped references*/
+}
+
+/**
+ * Collapses consecutive references to the same page into one reference and renumbers
+ * the pages densely in order of first appearance. The work is done in place and the
+ * number of references left is returned.
+ * int pages[]: page references, replaced by the collapsed and renumbered references.
+ * int runs[]: set to how many times in a row each collapsed reference occurred.
+ * int count: number of page references.
+ * int *numDistinct: set to the number of distinct pages, -1 if they could not be renumbered. **/
+
+int collapseTrace(int pages[], int runs[], int count, int *numDistinct) {
+
+	int i, n = 0;
+
+	/*run-length collapse consecutive duplicates*/
+	for (i = 0; i < count; i++) {
+		if (n > 0 && pages[n - 1] == pages[i]) {
+			runs[n - 1]++;
+		}
+		else {
+			pages[n] = pages[i];
+			runs[n] = 1;
+			n++;
+		}
+	}
+
+	*numDistinct = renumberTrace(pages, n);
+	return n;
+}
+
+/**
+ * Renumbers the pages densely from 0 in order of first appearance. Returns the number of
+ * distinct pages, or -1 if memory cannot be allocated and the pages keep their numbers.
+ * int pages[]: page references, replaced by the renumbered references.
+ * int n: number of page references. **/
+
+int renumberTrace(int pages[], int n) {
+
+	int i, numDistinct = 0;
+
+	if (n == 0) {
+		return 0;
+	}
+
+	/*sorted list of distinct pages, used to look up each page's index*/
+	int *sorted = (int*)malloc(n * sizeof(int));
+	int *ids = (int*)malloc(n * sizeof(int));
+	if (sorted == NULL || ids == NULL) {
+		free(sorted);
+		free(ids);
+		return -1; /*leave pages with their original numbers*/
+	}
+
+	memcpy(sorted, pages, n * sizeof(int));
+	qsort(sorted, n, sizeof(int), compareInt);
+
+	int distinct = 0;
+	for (i = 0; i < n; i++) {
+		if (distinct == 0 || sorted[distinct - 1] != sorted[i]) {
+			sorted[distinct] = sorted[i];
+			ids[distinct] = -1; /*not numbered yet*/
+			distinct++;
+		}
+	}
+
+	/*number pages in order of first appearance*/
+	for (i = 0; i < n; i++) {
+		int *key = (int*)bsearch(&pages[i], sorted, distinct, sizeof(int), compareInt);
+		int index = key - sorted;
+		if (ids[index] < 0) {
+			ids[index] = numDistinct;
+			numDistinct++;
+		}
+		pages[i] = ids[index];
+	}
+
+	free(sorted);
+	free(ids);
+	return numDistinct;
+}
+
+/**
+ * Loads the preprocessed trace for a file. If a cache that matches the file exists it
+ * is read, otherwise the file is read, collapsed and the cache is written for the next run.
+ * Returns 0 if the trace could not be read.
+ * char *fileName: name of the file containing the page references.
+ * int **pages: set to the collapsed page references.
+ * int **runs: set to the run length of each collapsed reference.
+ * int *count: set to the number of collapsed references. **/
+
+int loadTrace(char *fileName, int **pages, int **runs, int *count) {
+
+	struct stat src;
+	if (stat(fileName, &src) != 0) {
+		return 0;
+	}
+
+	/*name of the cache file*/
+	char *cacheName = (char*)malloc(strlen(fileName) + 5);
+	if (cacheName == NULL) {
+		return 0;
+	}
+	sprintf(cacheName, "%s.rle", fileName);
+
+	if (readCache(cacheName, &src, pages, runs, count)) {
+		free(cacheName);
+		return 1;
+	}
+
+	int total, numDistinct;
+	int *ref = readTrace(fileName, &total);
+	if (ref == NULL) {
+		free(cacheName);
+		return 0;
+	}
+
+	int *len = (int*)malloc((total > 0 ? total : 1) * sizeof(int));
+	if (len == NULL) {
+		free(ref);
+		free(cacheName);
+		return 0;
+	}
+
+	*count = collapseTrace(ref, len, total, &numDistinct);
+	writeCache(cacheName, &src, ref, len, *count, numDistinct, total);
+
+	*pages = ref;
+	*runs = len;
+	free(cacheName);
+	return 1;
+}
+
+/** Compares two integers for qsort and bsearch. **/
+
+static int compareInt(const void *a, const void *b) {
+
+	int x = *(const int*)a;
+	int y = *(const int*)b;
+	return (x > y) - (x < y);
+}
+
+/**
+ * Reads the cached preprocessed trace. Returns 0 if there is no cache or it does
+ * not belong to the current version of the trace file.
+ * char *cacheName: name of the cache file.
+ * struct stat *src: status of the original trace file. **/
+
+static int readCache(char *cacheName, struct stat *src, int **pages, int **runs, int *count) {
+
+	FILE *file = fopen(cacheName, "rb");
+	if (file == NULL) {
+		return 0;
+	}
+
+	struct traceCache head;
+	if (fread(&head, sizeof(head), 1, file) != 1 || head.magic != CACHE_MAGIC
+			|| head.srcSize != (long long)src->st_size || head.srcTime != (long long)src->st_mtim.tv_sec
+			|| head.srcNsec != (long long)src->st_mtim.tv_nsec || head.srcInode != (long long)src->st_ino
+			|| head.count < 0) {
+		fclose(file);
+		return 0; /*stale or damaged cache*/
+	}
+
+	int n = head.count > 0 ? head.count : 1;
+	int *ref = (int*)malloc(n * sizeof(int));
+	int *len = (int*)malloc(n * sizeof(int));
+	if (ref == NULL || len == NULL
+			|| fread(ref, sizeof(int), head.count, file) != (size_t)head.count
+			|| fread(len, sizeof(int), head.count, file) != (size_t)head.count) {
+		free(ref);
+		free(len);
+		fclose(file);
+		return 0;
+	}
+
+	fclose(file);
+	*pages = ref;
+	*runs = len;
+	*count = head.count;
+	return 1;
+}
+
+/**
+ * Writes the preprocessed trace to the cache file. The cache is written to a temporary file
+ * that is renamed into place, so a run that reads the cache at the same time never sees
+ * half of it. Failing to write the cache is not an error, the trace is simply preprocessed
+ * again on the next run.
+ * char *cacheName: name of the cache file.
+ * struct stat *src: status of the original trace file. **/
+
+static void writeCache(char *cacheName, struct stat *src, int pages[], int runs[], int count, int numDistinct, int total) {
+
+	char *tempName = (char*)malloc(strlen(cacheName) + 32);
+	if (tempName == NULL) {
+		return;
+	}
+	sprintf(tempName, "%s.%ld.tmp", cacheName, (long)getpid());
+
+	FILE *file = fopen(tempName, "wb");
+	if (file == NULL) {
+		free(tempName);
+		return;
+	}
+
+	struct traceCache head;
+	memset(&head, 0, sizeof(head));
+	head.magic = CACHE_MAGIC;
+	head.count = count;
+	head.numDistinct = numDistinct;
+	head.total = total;
+	head.srcSize = (long long)src->st_size;
+	head.srcTime = (long long)src->st_mtim.tv_sec;
+	head.srcNsec = (long long)src->st_mtim.tv_nsec;
+	head.srcInode = (long long)src->st_ino;
+
+	int ok = fwrite(&head, sizeof(head), 1, file) == 1
+		&& fwrite(pages, sizeof(int), count, file) == (size_t)count
+		&& fwrite(runs, sizeof(int), count, file) == (size_t)count;
+
+	ok = fclose(file) == 0 && ok;
+	if (!ok || rename(tempName, cacheName) != 0) {
+		remove(tempName); /*do not leave a partial cache behind*/
+	}
+	free(tempName);
+}